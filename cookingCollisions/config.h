@@ -10,3 +10,7 @@ constexpr int winHeight = 800;
 constexpr int FPS = 0;
 
 constexpr float pi = 3.141592653589793f;
+
+// Compiles the recipes in shippedRecipes.h into the game and answers recipe queries from constant tables,
+// instead of loading assets/recipes.txt at startup
+constexpr bool staticRecipes = false;
@@ -0,0 +1,44 @@
+#include "contentNames.h"
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ContentNames
+{
+	static PerfectHash loaded;
+
+	void Build(const FrozenRecipeGraph& recipes)
+	{
+		if constexpr (staticRecipes) return;
+
+		// The shipped names come first, so their slots are the same whichever recipes are loaded
+		std::vector<std::string> names;
+		names.reserve(shipped.GetSize() + recipes.GetIdCount());
+		for (size_t slot = 0; slot < shipped.GetSize(); slot++) names.emplace_back(shipped.GetName(slot));
+		for (size_t id = 0; id < recipes.GetIdCount(); id++) {
+			const std::string& name = recipes.GetName(static_cast<FrozenRecipeGraph::ItemId>(id));
+			if (shipped.Find(name) == npos) names.push_back(name);
+		}
+
+		if (!loaded.Build(std::move(names))) std::cerr << "Could not build the content name table" << std::endl;
+	}
+
+	size_t Find(std::string_view name)
+	{
+		if constexpr (staticRecipes) return shipped.Find(name);
+		else return loaded.Find(name);
+	}
+
+	std::string_view GetName(size_t slot)
+	{
+		if constexpr (staticRecipes) return shipped.GetName(slot);
+		else return loaded.GetName(slot);
+	}
+
+	size_t GetCount()
+	{
+		if constexpr (staticRecipes) return shipped.GetSize();
+		else return loaded.GetSize();
+	}
+}
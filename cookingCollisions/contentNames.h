@@ -0,0 +1,32 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include "config.h"
+#include "frozenRecipeGraph.h"
+#include "perfectHash.h"
+#include "shippedRecipes.h"
+
+// Gives every name the game keeps a texture for a slot, so assets live in flat arrays indexed by slot.
+// The shipped names are hashed at compile time, and recipes loaded from assets/recipes.txt add theirs at load time
+namespace ContentNames
+{
+	constexpr size_t npos = PerfectHashing::npos;
+
+	// Names that are never part of a recipe, for things that are drawn all the same
+	constexpr std::array<std::string_view, 2> extraNames = { "null", "plate" };
+
+	constexpr StaticPerfectHash<ShippedRecipes::items.size() + ShippedRecipes::inputs.size() + extraNames.size()> shipped(
+		PerfectHashing::JoinNames(PerfectHashing::JoinNames(ShippedRecipes::items, ShippedRecipes::inputs), extraNames));
+
+	static_assert(shipped.IsBuilt(), "A shipped name is listed twice");
+
+	// Hashes the shipped names along with every name in the recipes, which keeps a slot for everything the game names
+	// directly whatever the recipe file holds. Has no effect when staticRecipes is set
+	void Build(const FrozenRecipeGraph& recipes);
+
+	size_t Find(std::string_view name);
+	std::string_view GetName(size_t slot);
+	size_t GetCount();
+}
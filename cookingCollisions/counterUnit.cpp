@@ -1,8 +1,6 @@
 #include "counterUnit.h"
 #include "config.h"
 
-RecipeGraph& CounterUnit::recipes = RecipeGraph::GetInstance();
-
 // Constructor for the CounterUnit class
 CounterUnit::CounterUnit(const Vector2& pos, const std::array<bool, 4>& edges) :
     screenPos(pos)
@@ -14,20 +12,6 @@ CounterUnit::CounterUnit(const Vector2& pos, const std::array<bool, 4>& edges) :
     counterWidth = static_cast<float>(winHeight) / 10.f;
 }
 
-// Adds an item to the counter unit
-void CounterUnit::AddItem(BaseItem* item)
-{
-    // If empty, adds the item to the first slot
-    if (itemsPlaced[0] == nullptr) {
-        itemsPlaced[0] = item;
-    }
-
-    // Otherwise adds it to the second
-    else {
-        itemsPlaced[1] = item;
-    }
-}
-
 // Draws an outline showing that the unit is currently selected
 void CounterUnit::DrawSelected()
 {
@@ -36,51 +20,43 @@ void CounterUnit::DrawSelected()
 }
 
 // Checks if an item can be placed on a given unit
-bool CounterUnit::CanPlace(const std::string& type) const
+bool CounterUnit::CanPlace(RecipeGraph::ItemId type) const
 {
     // If the item being placed is compatible with what is already placed
-    if (itemsPlaced[0] == nullptr) return 1;
-    else if (recipes.FindCommonNode(itemsPlaced[0]->GetType(), type) != "NULL" && type != itemsPlaced[0]->GetType()) return 1;
-
-    return 0;
+    if (BaseItem::Get(itemsPlaced[0]) == nullptr) return 1;
+    return BaseItem::CanAddIngredient(itemsPlaced, type);
 }
 
 // Removes the current item and/or anything placed on it
 void CounterUnit::RemoveItems()
 {
-    for (auto item : itemsPlaced) {
-        if (item != nullptr)
+    for (ItemHandle slot : itemsPlaced) {
+        if (BaseItem* item = BaseItem::Get(slot))
             item->RemoveItems();  // Removes any item placed
     }
     ClearPlaced();
 }
 
-// Handles logic for combining two items
+// Handles logic for combining the placed items
 void CounterUnit::CombineItems()
 {
-    if (itemsPlaced[0] == nullptr || itemsPlaced[1] == nullptr) return;  // If either item is empty, exit
-
-    // Get the name of both items
-    std::string type1 = itemsPlaced[0]->GetType();
-    std::string type2 = itemsPlaced[1]->GetType();
+    std::optional<RecipeGraph::ItemId> combinedType = BaseItem::FindCombination(itemsPlaced);  // Find the result of combining the items
 
-    std::string combinedType = recipes.FindCommonNode(type1, type2);  // Find the result of combining the two items
-
-    // If FindCommonNode returns NULL, the items cannot be combined
-    if (combinedType != "NULL") {
-        combineItems = true;
+    // If FindCombination returns nothing, the items do not make a recipe yet
+    if (combinedType) {
         RemoveItems();
         ClearPlaced();
-        BaseItem* newItem = CreateCombinedItem(combinedType);  // Creates a new object based on the result of combining the items
+        BaseItem* newItem = CreateCombinedItem(*combinedType);  // Creates a new object based on the result of combining the items
         newItem->SetDimensions(50.f, 50.f);
-        if (newItem) AddItem(newItem);  // If the new item as created successfully, place it on the current object
+        AddItem(newItem);  // Places the new item on the current object
+        GameEvents::ItemCombined(newItem->GetHandle(), *combinedType);
     }
 }
 
 // Creates a new object of a given type
-BaseItem* CounterUnit::CreateCombinedItem(std::string& type)
+BaseItem* CounterUnit::CreateCombinedItem(RecipeGraph::ItemId type)
 {
-    return new Ingredient(BaseItem::GetDishTextures()[type], type);
+    return BaseItem::Create<Ingredient>(type);
 }
 
 // Handles logic and drawing the units
@@ -105,34 +81,37 @@ void CounterUnit::Tick(float deltaTime)
     DrawRectangle(static_cast<int>(screenPos.x), static_cast<int>(screenPos.y), static_cast<int>(counterWidth), static_cast<int>(counterWidth), BEIGE);  // The main body of the unit
 
     // Additional features if the unit is a bin
-    if (unitType == "bin") {
+    if (unitType == UnitType::Bin) {
         DrawCircle(static_cast<int>(screenPos.x + counterWidth / 2.f), static_cast<int>(screenPos.y + counterWidth / 2.f), static_cast<float>(counterWidth / 2.f - counterWidth / 6.f), { 80, 80, 80, 255 });
         DrawCircle(static_cast<int>(screenPos.x + counterWidth / 2.f), static_cast<int>(screenPos.y + counterWidth / 2.f), static_cast<float>(counterWidth / 2.f - counterWidth / 4.f), BLACK);
     }
 
     // Additional features if the unit is a delivery unit
-    else if (unitType == "delivery") {
+    else if (unitType == UnitType::Delivery) {
         DrawRectangle(static_cast<int>(screenPos.x + 10.f), static_cast<int>(screenPos.y), static_cast<int>(counterWidth - 20.f), static_cast<int>(counterWidth - 10.f), BLACK);
         DrawRectangle(static_cast<int>(screenPos.x + 10.f), static_cast<int>(screenPos.y - counterWidth), static_cast<int>(counterWidth - 20.f), static_cast <int>(2 * counterWidth - 10.f), BLACK);
     }
     
-    // Sets the position of any placed items to the unit's position
-    for (auto* item : itemsPlaced) {
-        if (item != nullptr) {
-            item->SetPos(GetCentre());
+    // Sets the position of any placed items to the unit's position, fanning out the ingredients of an unfinished recipe
+    for (size_t i = 0; i < itemsPlaced.size(); i++) {
+        if (BaseItem* item = BaseItem::Get(itemsPlaced[i])) {
+            float offset = static_cast<float>(i) * counterWidth / 8.f;
+            item->SetPos(Vector2{ GetCentre().x + offset, GetCentre().y - offset });
         }
     }
 
     // Makes items being served move up and despawn
-    for (auto* item : servingItems) {
-        if (item != nullptr) {
-            item->MovePos({ 0, -20 * deltaTime });  // Moves the item up
-
-            // If the item moves off the screen
-            if (item->GetPos().y < -50) {
-                item->RemoveItems();  // Removes the item from the game
-                servingItems.erase(servingItems.begin());
-            }
+    for (auto it = servingItems.begin(); it != servingItems.end();) {
+        BaseItem* item = BaseItem::Get(*it);
+
+        // Drops items that have already been destroyed, and removes items from the game once they move off the screen
+        if (item == nullptr || item->GetPos().y < -50) {
+            if (item != nullptr) item->RemoveItems();
+            it = servingItems.erase(it);
+            continue;
         }
+
+        item->MovePos({ 0, -20 * deltaTime });  // Moves the item up
+        ++it;
     }
 }
\ No newline at end of file
@@ -9,48 +9,49 @@
 class CounterUnit
 {
 public:
+    // What the unit does with items placed on it
+    enum class UnitType { Counter, Source, Bin, Delivery };
+
     CounterUnit(const Vector2& pos, const std::array<bool, 4>& edges);
-    void AddItem(BaseItem* item);
-    void AddServing(BaseItem* item) { servingItems.push_back(item); }
-    void ClearPlaced() { itemsPlaced = { nullptr, nullptr }; }
+    void AddItem(BaseItem* item) { if (item != nullptr) BaseItem::PlaceInSlots(itemsPlaced, item); }
+    void AddServing(BaseItem* item) { servingItems.push_back(item->GetHandle()); }
+    BaseItem* TakePlaced() { return BaseItem::TakeLastFromSlots(itemsPlaced); }
+    void ClearPlaced() { itemsPlaced.assign(BaseItem::GetSlotCount(), ItemHandle{}); }
+    void ClearServing() { servingItems.clear(); }
     void DrawSelected();
     void RemoveItems();
     void CombineItems();
-    BaseItem* CreateCombinedItem(std::string& type);
+    BaseItem* CreateCombinedItem(RecipeGraph::ItemId type);
     void Tick(float deltaTime);
 
-    void ResetFlags() { combineItems = false; }
-    bool CanPlace(const std::string& type) const;
+    bool CanPlace(RecipeGraph::ItemId type) const;
 
     // Getters
     Vector2 GetCentre() { return Vector2{ screenPos.x + counterWidth / 2.f, screenPos.y + counterWidth / 2.f }; }
     Vector2 GetPos() { return screenPos; }
     float GetWidth() { return counterWidth; }
     bool GetSelected() { return isSelected; }
-    BaseItem* GetPlaced() { return itemsPlaced[0]; }
-    std::string GetType() { return unitType; }
-    std::string GetSourceType() { return sourceType; }
-    bool GetCombine() { return combineItems; }
+    BaseItem* GetPlaced() { return BaseItem::Get(itemsPlaced[0]); }
+    BaseItem* GetLastPlaced() const { return BaseItem::FindLastInSlots(itemsPlaced); }
+    UnitType GetType() const { return unitType; }
+    const std::string& GetSourceType() const { return sourceType; }
 
     // Setters
     void SetSelected(bool state) { isSelected = state; }
-    void SetType(const std::string& type, const std::string& spawnerType = "none") { unitType = type; sourceType = spawnerType; }
+    void SetType(UnitType type, const std::string& spawnerType = "none") { unitType = type; sourceType = spawnerType; }
 
 private:
     Vector2 screenPos{};
-    std::array<BaseItem*, 2> itemsPlaced = { nullptr, nullptr };
-    std::vector<BaseItem*> servingItems;
+    std::vector<ItemHandle> itemsPlaced = std::vector<ItemHandle>(BaseItem::GetSlotCount());
+    std::vector<ItemHandle> servingItems;
     std::array<bool, 4> counterEdges;
 
     bool isSelected = false;
 
-    std::string unitType = "default";
-    std::string sourceType = "none";
+    UnitType unitType = UnitType::Counter;
+    std::string sourceType = "none";  // Only read when a source spawns an item
 
     float counterWidth;
     float outlineThickness = 2.f;
     float edgeThickness = 4.f;
-
-    bool combineItems = false;
-    static RecipeGraph& recipes;
 };
@@ -0,0 +1,98 @@
+#include "fileWatcher.h"
+
+// windows.h clashes with raylib.h, so it is only included in this file
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+// Reads the last write time of a file, or 0 if it cannot be read
+static long long GetLastWriteTime(const std::string& path)
+{
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &attributes)) return 0;
+    return (static_cast<long long>(attributes.ftLastWriteTime.dwHighDateTime) << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+}
+
+FileWatcher::FileWatcher(const std::string& path)
+{
+    size_t slash = path.find_last_of("/\\");
+    directory = slash == std::string::npos ? "." : path.substr(0, slash);
+    fileName = slash == std::string::npos ? path : path.substr(slash + 1);
+    lastWriteTime = GetLastWriteTime(path);
+
+    HANDLE notification = FindFirstChangeNotificationA(directory.c_str(), FALSE,
+        FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+    if (notification != INVALID_HANDLE_VALUE) notifyHandle = notification;
+}
+
+FileWatcher::~FileWatcher()
+{
+    if (notifyHandle != nullptr) FindCloseChangeNotification(notifyHandle);
+}
+
+bool FileWatcher::HasChanged()
+{
+    if (notifyHandle == nullptr || WaitForSingleObject(notifyHandle, 0) != WAIT_OBJECT_0) return false;
+    FindNextChangeNotification(notifyHandle);
+
+    long long writeTime = GetLastWriteTime(directory + "\\" + fileName);
+    if (writeTime == lastWriteTime) return false;
+    lastWriteTime = writeTime;
+    return true;
+}
+
+bool FileWatcher::IsWatching() const
+{
+    return notifyHandle != nullptr;
+}
+
+#else
+
+FileWatcher::FileWatcher(const std::string& path)
+{
+    size_t slash = path.find_last_of('/');
+    directory = slash == std::string::npos ? "." : path.substr(0, slash);
+    fileName = slash == std::string::npos ? path : path.substr(slash + 1);
+
+    notifyFile = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (notifyFile < 0) return;
+    watchDescriptor = inotify_add_watch(notifyFile, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+}
+
+FileWatcher::~FileWatcher()
+{
+    if (notifyFile >= 0) close(notifyFile);
+}
+
+bool FileWatcher::HasChanged()
+{
+    if (watchDescriptor < 0) return false;
+
+    // Drains every waiting event, so a save that is several writes only reports one change
+    bool changed = false;
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(notifyFile, buffer, sizeof(buffer))) > 0) {
+        for (ssize_t offset = 0; offset < length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            if (event->len > 0 && fileName == event->name) changed = true;
+            offset += sizeof(inotify_event) + event->len;
+        }
+    }
+    return changed;
+}
+
+bool FileWatcher::IsWatching() const
+{
+    return watchDescriptor >= 0;
+}
+
+#endif
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+
+// Watches a file for changes without blocking, through inotify on Linux and a change notification on Windows.
+// Editors often save by writing a new file and renaming it over the old one, so the file's directory is watched
+class FileWatcher
+{
+public:
+	FileWatcher(const std::string& path);
+	~FileWatcher();
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+	// Returns true once for each batch of changes since the last call
+	bool HasChanged();
+
+	// Getters
+	bool IsWatching() const;
+
+private:
+	std::string directory;
+	std::string fileName;
+
+	// Platform handles, kept as void* and int so that windows.h is never included next to raylib.h
+	void* notifyHandle = nullptr;
+	long long lastWriteTime = 0;  // Tells changes to the file apart from changes to the rest of its directory on Windows
+	int notifyFile = -1;
+	int watchDescriptor = -1;
+};
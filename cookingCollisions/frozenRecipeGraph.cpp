@@ -0,0 +1,104 @@
+#include "frozenRecipeGraph.h"
+
+// Copies the graph into flat arrays and builds everything the mutable graph would otherwise build on demand
+FrozenRecipeGraph::FrozenRecipeGraph(const RecipeGraph& recipes) :
+	combinations(recipes.combinations),
+	transitions(recipes.transitions),
+	tableStorage(recipes.tableStorage),
+	revision(recipes.revision)
+{
+	nameIndex.Build(recipes.names);
+
+	size_t nodeCount = GetIdCount();
+	nodes.reserve(nodeCount + 1);
+	for (size_t node = 0; node < nodeCount; node++) {
+		nodes.push_back({ static_cast<std::uint32_t>(edges.size()), static_cast<std::uint32_t>(producers.size()),
+			static_cast<std::uint32_t>(requiredInputs.size()) });
+		edges.insert(edges.end(), recipes.idGraph[node].begin(), recipes.idGraph[node].end());
+		producers.insert(producers.end(), recipes.producers[node].begin(), recipes.producers[node].end());
+		requiredInputs.insert(requiredInputs.end(), recipes.requiredInputs[node].begin(), recipes.requiredInputs[node].end());
+	}
+	nodes.push_back({ static_cast<std::uint32_t>(edges.size()), static_cast<std::uint32_t>(producers.size()),
+		static_cast<std::uint32_t>(requiredInputs.size()) });
+
+	if (recipes.reachabilityDirty) recipes.BuildReachability();
+	reachability = recipes.reachability;
+	reachabilityWords = recipes.reachabilityWords;
+
+	if (recipes.recipesDirty) recipes.BuildRecipes();
+	this->recipes = recipes.recipes;
+	recipeTable = recipes.recipeTable;
+
+	if (recipes.topologyDirty) recipes.BuildTopology();
+	topologicalOrder = recipes.topologicalOrder;
+	recipeDepths = recipes.recipeDepths;
+}
+
+std::optional<FrozenRecipeGraph::ItemId> FrozenRecipeGraph::GetId(const std::string& name) const
+{
+	size_t index = nameIndex.Find(name);
+	if (index == nameIndex.npos) return std::nullopt;
+	return static_cast<ItemId>(index);
+}
+
+FrozenRecipeGraph::Range<RecipeGraph::IdEdge> FrozenRecipeGraph::GetNeighbors(ItemId node) const
+{
+	if (node >= GetIdCount()) return { nullptr, nullptr };
+	return { edges.data() + nodes[node].edgeStart, edges.data() + nodes[node + 1].edgeStart };
+}
+
+FrozenRecipeGraph::Range<RecipeGraph::Producer> FrozenRecipeGraph::GetProducers(ItemId node) const
+{
+	if (node >= GetIdCount()) return { nullptr, nullptr };
+	return { producers.data() + nodes[node].producerStart, producers.data() + nodes[node + 1].producerStart };
+}
+
+FrozenRecipeGraph::Range<FrozenRecipeGraph::ItemId> FrozenRecipeGraph::GetRequiredInputs(ItemId node) const
+{
+	if (node >= GetIdCount()) return { nullptr, nullptr };
+	return { requiredInputs.data() + nodes[node].inputStart, requiredInputs.data() + nodes[node + 1].inputStart };
+}
+
+std::optional<FrozenRecipeGraph::ItemId> FrozenRecipeGraph::FindCommonNode(ItemId node1, ItemId node2) const
+{
+	ItemId commonNode = combinations.Get(node1, node2);
+	if (commonNode == PairTable::noItem) return std::nullopt;
+	return commonNode;
+}
+
+std::optional<FrozenRecipeGraph::ItemId> FrozenRecipeGraph::GetInputForEdge(ItemId from, ItemId to) const
+{
+	for (const auto& neighbor : GetNeighbors(from)) {
+		if (neighbor.destination == to) {
+			return neighbor.input;
+		}
+	}
+	return std::nullopt;
+}
+
+std::optional<FrozenRecipeGraph::ItemId> FrozenRecipeGraph::ApplyInputToNode(ItemId from, ItemId input) const
+{
+	ItemId destination = transitions.Get(from, input);
+	if (destination == PairTable::noItem) return std::nullopt;
+	return destination;
+}
+
+bool FrozenRecipeGraph::CanBecome(ItemId item, ItemId dish) const
+{
+	if (item >= GetIdCount() || dish >= GetIdCount()) return false;
+	return (reachability[item * reachabilityWords + dish / 64] >> (dish % 64)) & 1;
+}
+
+void FrozenRecipeGraph::FindDeadEnds(const std::vector<ItemId>& items, const std::vector<ItemId>& dishes, std::vector<bool>& deadEnds) const
+{
+	RecipeGraph::MarkDeadEnds(reachability, reachabilityWords, items, dishes, deadEnds);
+}
+
+// Bytes used by the arrays and tables, not counting the name strings
+size_t FrozenRecipeGraph::GetMemoryUsage() const
+{
+	return nodes.capacity() * sizeof(Node) + edges.capacity() * sizeof(RecipeGraph::IdEdge) +
+		producers.capacity() * sizeof(RecipeGraph::Producer) + requiredInputs.capacity() * sizeof(ItemId) +
+		reachability.capacity() * sizeof(std::uint64_t) + combinations.GetMemoryUsage() + transitions.GetMemoryUsage() +
+		recipeTable.GetMemoryUsage() + nameIndex.GetMemoryUsage() + topologicalOrder.capacity() * sizeof(ItemId) + recipeDepths.capacity();
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "multisetTable.h"
+#include "pairTable.h"
+#include "perfectHash.h"
+#include "recipeGraph.h"
+
+// An immutable copy of a RecipeGraph, made by RecipeGraph::Freeze.
+// Nodes live in one contiguous array that indexes flat edge, producer and input arrays, and every
+// table is built up front, so any number of threads can query one snapshot at the same time.
+// Snapshots are independent of the graph they came from and of each other, so several recipe sets
+// can be played side by side
+class FrozenRecipeGraph
+{
+public:
+	using ItemId = RecipeGraph::ItemId;
+
+	static constexpr ItemId noItem = RecipeGraph::noItem;
+
+	// A read-only view of part of one of the flat arrays
+	template <typename T>
+	struct Range {
+		const T* first;
+		const T* last;
+
+		const T* begin() const { return first; }
+		const T* end() const { return last; }
+		size_t size() const { return static_cast<size_t>(last - first); }
+		bool empty() const { return first == last; }
+		const T& operator[](size_t index) const { return first[index]; }
+	};
+
+	explicit FrozenRecipeGraph(const RecipeGraph& recipes);
+	FrozenRecipeGraph(const FrozenRecipeGraph&) = delete;
+	FrozenRecipeGraph& operator=(const FrozenRecipeGraph&) = delete;
+
+	std::optional<ItemId> GetId(const std::string& name) const;
+	const std::string& GetName(ItemId id) const { return nameIndex.GetName(id); }
+	size_t GetIdCount() const { return nameIndex.GetSize(); }
+
+	Range<RecipeGraph::IdEdge> GetNeighbors(ItemId node) const;
+	Range<RecipeGraph::Producer> GetProducers(ItemId node) const;
+	Range<ItemId> GetRequiredInputs(ItemId node) const;
+
+	std::optional<ItemId> FindCommonNode(ItemId node1, ItemId node2) const;
+	std::optional<ItemId> GetInputForEdge(ItemId from, ItemId to) const;
+	std::optional<ItemId> ApplyInputToNode(ItemId from, ItemId input) const;
+
+	MultisetTable::Match MatchRecipe(const ItemId* ingredients, size_t count) const { return recipeTable.Find(ingredients, count); }
+	const std::vector<RecipeGraph::Recipe>& GetRecipes() const { return recipes; }
+	size_t GetMaxRecipeSize() const { return recipeTable.GetMaxRecipeSize(); }
+
+	const std::vector<ItemId>& GetTopologicalOrder() const { return topologicalOrder; }
+	std::uint8_t GetRecipeDepth(ItemId item) const { return item < recipeDepths.size() ? recipeDepths[item] : RecipeGraph::noDepth; }
+
+	bool CanBecome(ItemId item, ItemId dish) const;
+	void FindDeadEnds(const std::vector<ItemId>& items, const std::vector<ItemId>& dishes, std::vector<bool>& deadEnds) const;
+
+	// Getters
+	std::uint32_t GetRevision() const { return revision; }  // Revision of the graph when it was frozen
+	size_t GetMemoryUsage() const;
+
+private:
+	// Where each node's entries start in the flat arrays, the next node's starts mark where they end
+	struct Node {
+		std::uint32_t edgeStart;
+		std::uint32_t producerStart;
+		std::uint32_t inputStart;
+	};
+
+	std::vector<Node> nodes;  // One more than the node count, the last entry ends the final node's ranges
+	std::vector<RecipeGraph::IdEdge> edges;
+	std::vector<RecipeGraph::Producer> producers;
+	std::vector<ItemId> requiredInputs;
+
+	PerfectHash nameIndex;  // Built with the snapshot, so a name is found in one probe
+
+	PairTable combinations;
+	PairTable transitions;
+	std::shared_ptr<const void> tableStorage;  // Keeps tables attached to a mapped file alive
+
+	std::vector<RecipeGraph::Recipe> recipes;
+	MultisetTable recipeTable;
+
+	std::vector<ItemId> topologicalOrder;
+	std::vector<std::uint8_t> recipeDepths;
+
+	std::vector<std::uint64_t> reachability;
+	size_t reachabilityWords;
+
+	std::uint32_t revision;
+};
@@ -0,0 +1,5 @@
+#include "gameEvents.h"
+
+// Defines static attributes
+thread_local std::vector<GameEvent> GameEvents::queue;
+thread_local std::vector<GameEvent> GameEvents::draining;
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "recipeGraph.h"
+#include "itemStore.h"
+
+class Order;
+
+// Something that happened during a frame which the main loop has to react to
+struct GameEvent {
+	enum class Type : std::uint8_t {
+		ItemCombined,
+		ItemProcessed,
+		ItemRemoved,
+		DishServed,
+		OrderExpired
+	};
+
+	Type type;
+	ItemHandle item;  // The item made by combining, processed by a station, removed or served
+	RecipeGraph::ItemId dish = RecipeGraph::noItem;  // The type combined or processed into, or the dish served
+	const Order* order = nullptr;  // The order that ran out of time
+};
+
+// Events are pushed by whatever causes them and drained once a frame, so reacting to them costs as much as the
+// events that happened rather than a scan over every item and unit
+class GameEvents
+{
+public:
+	static void Push(const GameEvent& event) { queue.push_back(event); }
+	static void ItemCombined(ItemHandle item, RecipeGraph::ItemId type) { Push({ GameEvent::Type::ItemCombined, item, type }); }
+	static void ItemProcessed(ItemHandle item, RecipeGraph::ItemId type) { Push({ GameEvent::Type::ItemProcessed, item, type }); }
+	static void ItemRemoved(ItemHandle item) { Push({ GameEvent::Type::ItemRemoved, item }); }
+	static void DishServed(ItemHandle item, RecipeGraph::ItemId dish) { Push({ GameEvent::Type::DishServed, item, dish }); }
+	static void OrderExpired(const Order* order) { Push({ GameEvent::Type::OrderExpired, {}, RecipeGraph::noItem, order }); }
+
+	template<typename Handler>
+	static void Drain(Handler&& handler);
+	static void Clear() { queue.clear(); }
+
+	// Getters
+	static size_t GetSize() { return queue.size(); }
+
+private:
+	static thread_local std::vector<GameEvent> queue;
+	static thread_local std::vector<GameEvent> draining;  // Kept between frames so draining never allocates
+};
+
+// Passes every queued event to the handler in the order they were pushed. Events pushed while draining are
+// handled in the same drain, after the ones already queued
+template<typename Handler>
+inline void GameEvents::Drain(Handler&& handler)
+{
+	while (!queue.empty()) {
+		std::swap(queue, draining);
+		for (const GameEvent& event : draining) handler(event);
+		draining.clear();
+	}
+}
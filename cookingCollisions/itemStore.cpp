@@ -0,0 +1,43 @@
+#include "itemStore.h"
+
+// Adds an item with its data cleared, the item fills in the rest as it is constructed
+ItemHandle ItemStore::Insert(BaseItem* owner, RecipeGraph::ItemId type)
+{
+	ItemHandle handle = live.Insert(owner);
+	positions.push_back({ 0.f, 0.f });
+	sizes.push_back({ 0.f, 0.f });
+	angles.push_back(0.f);
+	types.push_back(type);
+	states.push_back(ItemState::Default);
+	textureSets.push_back(0);
+	parents.push_back({});
+	parentSlots.push_back(0);
+	return handle;
+}
+
+// Removes an item's entries, keeping every array in step with the live list
+void ItemStore::Remove(ItemHandle handle)
+{
+	size_t position = live.GetPosition(handle);
+	if (position == npos) return;
+	live.Remove(handle);
+
+	auto removeAt = [position](auto& values) {
+		values[position] = values.back();
+		values.pop_back();
+	};
+	removeAt(positions);
+	removeAt(sizes);
+	removeAt(angles);
+	removeAt(types);
+	removeAt(states);
+	removeAt(textureSets);
+	removeAt(parents);
+	removeAt(parentSlots);
+}
+
+BaseItem* ItemStore::Find(ItemHandle handle) const
+{
+	BaseItem* const* owner = live.Find(handle);
+	return owner != nullptr ? *owner : nullptr;
+}
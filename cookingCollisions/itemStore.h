@@ -0,0 +1,54 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+#include "recipeGraph.h"
+#include "slotMap.h"
+
+class BaseItem;
+
+// What has been done to an item, which picks the texture it is drawn with
+enum class ItemState : std::uint8_t {
+	Default,
+	Chopped,
+	Cooked
+};
+
+constexpr size_t itemStateCount = 3;
+
+// Items are held through handles into the list of live items, which go stale rather than dangle once an item is destroyed
+using ItemHandle = SlotHandle;
+
+// The data every live item uses each frame, kept in arrays in the order of the live list rather than in the items
+// themselves. Batch passes walk the arrays in order without touching the items, and an item reaches its own entries
+// through its handle. Removing an item moves the last entry of every array into its place
+class ItemStore
+{
+public:
+	static constexpr size_t npos = SlotMap<BaseItem*>::npos;
+
+	ItemHandle Insert(BaseItem* owner, RecipeGraph::ItemId type);
+	void Remove(ItemHandle handle);
+
+	// Getters
+	size_t GetPosition(ItemHandle handle) const { return live.GetPosition(handle); }
+	BaseItem* Find(ItemHandle handle) const;
+	const std::vector<BaseItem*>& GetOwners() const { return live.GetValues(); }
+	size_t GetSize() const { return live.GetSize(); }
+
+private:
+	friend class BaseItem;
+
+	SlotMap<BaseItem*> live;
+
+	// Indexed by position in the live list
+	std::vector<Vector2> positions;
+	std::vector<Vector2> sizes;
+	std::vector<float> angles;
+	std::vector<RecipeGraph::ItemId> types;
+	std::vector<ItemState> states;
+	std::vector<std::uint32_t> textureSets;  // The set of the type the item was created as, which chopping or cooking it does not change
+	std::vector<ItemHandle> parents;  // The item each one is placed on, null for items on counters or in hands
+	std::vector<std::uint8_t> parentSlots;  // Which of its parent's slots each item is in
+};
@@ -1,320 +1,656 @@
 #include "items.h"
+#include "recipeLoader.h"
+#include "order.h"
 
 // Defines static attributes
-std::unordered_map<std::string, std::map<std::string, Texture2D>> BaseItem::dishTextures;
-RecipeGraph& BaseItem::recipes = RecipeGraph::GetInstance();
-std::vector<std::string> BaseItem::orderedDishes;
-std::unordered_map<std::string, Sound> BaseItem::soundEffects;
+std::vector<TextureSet> BaseItem::textureSets;
+TextureAtlas BaseItem::atlas;
+std::vector<BaseItem::QueuedTexture> BaseItem::queuedTextures;
+thread_local std::shared_ptr<const FrozenRecipeGraph> BaseItem::recipes;
+std::vector<RecipeGraph::ItemId> BaseItem::orderedDishes;
+thread_local VoicePool BaseItem::soundEffects;
+thread_local std::array<VoicePool::EffectId, stationCount> BaseItem::stationSounds;
+thread_local std::array<RecipeGraph::ItemId, stationCount> BaseItem::stationInputs;
+thread_local RecipeGraph::ItemId BaseItem::plateType = RecipeGraph::noItem;
+thread_local size_t BaseItem::slotCount = 2;
+thread_local std::vector<RecipeGraph::ItemId> BaseItem::ingredientScratch;
+thread_local bool BaseItem::deadItemsDirty = true;
+thread_local std::vector<RecipeGraph::ItemId> BaseItem::flaggedDishes;
+thread_local std::vector<RecipeGraph::ItemId> BaseItem::dishScratch;
+thread_local std::vector<RecipeGraph::ItemId> BaseItem::flaggedItems;
+thread_local std::vector<bool> BaseItem::deadEnds;
+thread_local RecipePlanner::StateHash BaseItem::kitchen;
+thread_local ItemStore BaseItem::store;
+thread_local TimerWheel<ItemHandle> BaseItem::stations;
+thread_local std::array<std::vector<BaseItem*>, drawLayerCount> BaseItem::layers;
+
+// Adds the item to the store and its layer, and finds the texture set of its type once. Types without one are drawn
+// with the null texture
+BaseItem::BaseItem(RecipeGraph::ItemId type, DrawLayer layer) :
+    baseLayer(layer), drawLayer(layer)
+{
+    handle = store.Insert(this, type);
+    size_t index = GetIndex();
+    store.sizes[index] = { 75.f * static_cast<float>(winWidth) / 800.f, 75.f * static_cast<float>(winWidth) / 800.f };
+
+    size_t textureSet = ContentNames::Find(GetTypeName());
+    if (textureSet >= textureSets.size()) textureSet = ContentNames::Find("null");
+    store.textureSets[index] = static_cast<std::uint32_t>(textureSet);
+
+    JoinLayer(layer);
+    deadItemsDirty = true;
+}
+
+BaseItem::~BaseItem()
+{
+    LeaveLayer();
+    StopStation();
+    LeaveKitchen();
+    store.Remove(handle);
+    deadItemsDirty = true;
+}
+
+// The pool items on the calling thread are made in, alongside the recipes and kitchen of that thread. Items still in
+// it when the thread exits are freed without their destructors, which would use the store and layers as they go
+ItemPool& BaseItem::GetPool()
+{
+    static thread_local ItemPool pool;
+    return pool;
+}
 
-// Static method to load and process textures
-Texture2D BaseItem::LoadTexture(std::string path)
+// Destroys an item, which takes it out of the store and leaves every handle to it stale
+void BaseItem::Destroy(BaseItem* item)
 {
-    Image plateImage = LoadImage(path.c_str());  // Loads the image from the given path
-    ImageAlphaPremultiply(&plateImage);  // Multiplies all RGB values by the alpha channel to ensure smoother blending
-    ImageMipmaps(&plateImage);  // Generates images pre-scales to different sizes for scaling
-    Texture2D plateTexture = LoadTextureFromImage(plateImage);  // Loads the texture from the image so that it can be used by the GPU
-    SetTextureFilter(plateTexture, TEXTURE_FILTER_TRILINEAR);  // Applies trilinear filtering for smooth interpolation for scaled textures
-    UnloadImage(plateImage);  // Unloads the image as it is no longer in use
+    GetPool().Destroy(item);
+}
 
-    return plateTexture;
+// Destroys every item at once, for the end of a round
+void BaseItem::DestroyAll()
+{
+    GetPool().Reset();
 }
 
 // Static method
 void BaseItem::SetupClass()
 {
-    soundEffects["frying"] = LoadSound("assets/FryingSFX.mp3");
-    SetSoundVolume(soundEffects["frying"], 0.5f);
+    // Loads the recipe DAG, from the compiled-in tables or from the recipe file and its compiled cache
+    RecipeGraph& recipeGraph = RecipeGraph::GetInstance();
+    if constexpr (staticRecipes) {
+        RecipeLoader::LoadShipped(recipeGraph);
+    }
+    else if (!RecipeLoader::Load(recipeGraph, "assets/recipes.txt", "assets/recipes.bin")) {
+        std::cerr << "Could not load assets/recipes.txt, using the shipped recipes instead" << std::endl;
+        RecipeLoader::LoadShipped(recipeGraph);
+    }
 
-    soundEffects["chopping"] = LoadSound("assets/ChoppingSFX.mp3");
-    SetSoundVolume(soundEffects["chopping"], 0.3f);
+    // Plates are items but no recipe uses them, so their type is interned alongside the recipes
+    recipeGraph.Intern("plate");
 
-    // Stores all available ingredients and dishes as nodes in a DAG
-    std::vector<std::string> items = { "sweet crystal", "spice particle", "energy particle", "liquid essence",
-        "protein orb", "vegetable core", "aroma sphere", "cooling shard", "caramel essence", "frozen spice mix",
-        "protein veg mix", "spiced liquid", "sugar shards", "icy sweet mix", "caramel energy cube",
-        "spicy frost bomb", "protein salad", "liquid flame soup", "frosted energy treat"};
-    for (const auto item : items) {
-        recipes.AddNode(item);
+    // Items only ever read the recipes, through a snapshot
+    UseRecipes(recipeGraph.Freeze());
+
+    // Textures are kept in arrays indexed by the slot of their name
+    ContentNames::Build(GetRecipes());
+    textureSets.assign(ContentNames::GetCount(), {});
+
+    // Sounds get enough voices for a busy kitchen, past that the oldest one is cut off. Stations find theirs once here
+    soundEffects.Load("frying", "assets/FryingSFX.mp3", 0.5f, 8);
+    soundEffects.Load("chopping", "assets/ChoppingSFX.mp3", 0.3f, 4);
+    for (size_t station = 0; station < stationCount; station++) {
+        stationSounds[station] = soundEffects.Find(stationTable[station].sound);
     }
 
-    // Adds edges between nodes with an input, which indicate what can be turned into what, and how
-    recipes.AddEdge("sweet crystal", "caramel essence", "frying pan");
-    recipes.AddEdge("caramel essence", "caramel energy cube");
-    recipes.AddEdge("energy particle", "caramel energy cube");
+    // Loads static textures to be used for non-spawning dishes
+    AddTexture("caramel energy cube", ItemState::Default, "assets/CaramelEnergyCube.png");
 
-    recipes.AddEdge("spice particle", "frozen spice mix");
-    recipes.AddEdge("cooling shard", "frozen spice mix");
-    recipes.AddEdge("frozen spice mix", "spicy frost bomb", "chopping board");
+    AddTexture("frozen spice mix", ItemState::Default, "assets/FrozenSpiceMix.png");
+    AddTexture("frozen spice mix", ItemState::Chopped, "assets/SpicyFrostBomb.png");
 
-    recipes.AddEdge("protein orb", "protein veg mix");
-    recipes.AddEdge("vegetable core", "protein veg mix");
-    recipes.AddEdge("protein veg mix", "protein salad");
-    recipes.AddEdge("aroma sphere", "protein salad");
+    AddTexture("protein salad", ItemState::Default, "assets/ProteinSalad.png");
 
-    recipes.AddEdge("liquid essence", "spiced liquid");
-    recipes.AddEdge("spice particle", "spiced liquid");
-    recipes.AddEdge("spiced liquid", "liquid flame soup", "frying pan");
+    AddTexture("spiced liquid", ItemState::Default, "assets/SpicedLiquid.png");
+    AddTexture("spiced liquid", ItemState::Cooked, "assets/LiquidFlameSoup.png");
 
-    recipes.AddEdge("sweet crystal", "sugar shards", "chopping board");
-    recipes.AddEdge("sugar shards", "icy sweet mix");
-    recipes.AddEdge("cooling shard", "icy sweet mix");
-    recipes.AddEdge("icy sweet mix", "frosted energy treat");
-    recipes.AddEdge("energy particle", "frosted energy treat");
+    AddTexture("frosted energy treat", ItemState::Default, "assets/FrostedEnergyTreat.png");
 
-    // Loads static textures to be used for non-spawning dishes
-    std::map<std::string, Texture2D> caramelEnergyCubeTextures;
-    caramelEnergyCubeTextures["default"] = LoadTexture("assets/CaramelEnergyCube.png");
-    dishTextures["caramel energy cube"] = caramelEnergyCubeTextures;
+    AddTexture("protein veg mix", ItemState::Default, "assets/ProteinVegMix.png");
+
+    AddTexture("icy sweet mix", ItemState::Default, "assets/IcySweetMix.png");
+
+}
+
+// Applies changes to assets/recipes.txt while the game runs. The shared graph keeps every name it has seen, so items
+// already in play keep valid types, and only the table entries of changed items are rebuilt before it is frozen again
+bool BaseItem::ReloadRecipes()
+{
+    if constexpr (staticRecipes) return false;
+
+    RecipeGraph& recipeGraph = RecipeGraph::GetInstance();
+    if (!RecipeLoader::Reload(recipeGraph, "assets/recipes.txt", "assets/recipes.bin")) return false;
+    recipeGraph.Intern("plate");  // The file never declares it, so reloading leaves it undeclared
+    UseRecipes(recipeGraph.Freeze());
+
+    // New names are added after the existing ones, so the slots of loaded assets do not move
+    ContentNames::Build(GetRecipes());
+    textureSets.resize(ContentNames::GetCount());
+    return true;
+}
+
+// Sets the recipes items on the calling thread use. Each simulation thread can play its own snapshot
+void BaseItem::UseRecipes(std::shared_ptr<const FrozenRecipeGraph> snapshot)
+{
+    recipes = std::move(snapshot);
+
+    // Resolves the tool inputs to IDs so per-frame queries never touch strings
+    for (size_t station = 0; station < stationCount; station++) {
+        stationInputs[station] = recipes->GetId(std::string(stationTable[station].input)).value_or(RecipeGraph::noItem);
+    }
+    plateType = recipes->GetId("plate").value_or(RecipeGraph::noItem);
+
+    // Plates and counters need a slot for every ingredient of the largest recipe, and always two so items can be stacked
+    slotCount = std::max<size_t>(2, recipes->GetMaxRecipeSize());
+    ingredientScratch.reserve(slotCount + 1);
+    deadItemsDirty = true;
+}
+
+// Checks whether an item can join the items already placed somewhere. Each placement sorts at most a recipe's worth of
+// IDs and makes one hash probe, which tells whether the items are still part of some recipe
+bool BaseItem::CanAddIngredient(const std::vector<ItemHandle>& placed, RecipeGraph::ItemId type)
+{
+    if (type == RecipeGraph::noItem) return 0;
+
+    std::vector<RecipeGraph::ItemId>& ingredients = ingredientScratch;
+    ingredients.clear();
+    for (ItemHandle slot : placed) {
+        BaseItem* item = Get(slot);
+        if (item == nullptr) continue;
+        if (item->GetType() == RecipeGraph::noItem) return 0;
+        ingredients.push_back(item->GetType());
+    }
+
+    // There has to be a free slot left
+    if (ingredients.size() >= placed.size()) return 0;
 
-    std::map<std::string, Texture2D> frozenSpiceMixTextures;
-    frozenSpiceMixTextures["default"] = LoadTexture("assets/FrozenSpiceMix.png");
-    frozenSpiceMixTextures["chopped"] = LoadTexture("assets/SpicyFrostBomb.png");
-    dishTextures["frozen spice mix"] = frozenSpiceMixTextures;
+    ingredients.push_back(type);
 
-    std::map<std::string, Texture2D> proteinSaladTextures;
-    proteinSaladTextures["default"] = LoadTexture("assets/ProteinSalad.png");
-    dishTextures["protein salad"] = proteinSaladTextures;
+    std::sort(ingredients.begin(), ingredients.end());
+    return MatchIngredients(ingredients).isPart;
+}
+
+// Finds what the items placed somewhere make, if they complete a recipe
+std::optional<RecipeGraph::ItemId> BaseItem::FindCombination(const std::vector<ItemHandle>& placed)
+{
+    // Most things hold one item or none, which can never complete a recipe
+    size_t placedCount = std::count_if(placed.begin(), placed.end(), [](ItemHandle slot) { return Get(slot) != nullptr; });
+    if (placedCount < 2) return std::nullopt;
+
+    std::vector<RecipeGraph::ItemId>& ingredients = ingredientScratch;
+    ingredients.clear();
+    for (ItemHandle slot : placed) {
+        BaseItem* item = Get(slot);
+        if (item == nullptr) continue;
+        if (item->GetType() == RecipeGraph::noItem) return std::nullopt;
+        ingredients.push_back(item->GetType());
+    }
+
+    std::sort(ingredients.begin(), ingredients.end());
+    RecipeGraph::ItemId result = MatchIngredients(ingredients).result;
+    if (result == RecipeGraph::noItem) return std::nullopt;
+    return result;
+}
+
+// Flags every ingredient and dish that can no longer be turned into any open order, tools and plates are never flagged
+void BaseItem::FlagDeadItems(const std::vector<BaseItem*>& items, const std::vector<Order*>& orders)
+{
+    dishScratch.clear();
+    for (Order* order : orders) {
+        if (order->GetDishId() != RecipeGraph::noItem) dishScratch.push_back(order->GetDishId());
+    }
 
-    std::map<std::string, Texture2D> spicedLiquidTextures;
-    spicedLiquidTextures["default"] = LoadTexture("assets/SpicedLiquid.png");
-    spicedLiquidTextures["cooked"] = LoadTexture("assets/LiquidFlameSoup.png");
-    dishTextures["spiced liquid"] = spicedLiquidTextures;
+    // Nothing an item could still become has changed since the last pass
+    if (!deadItemsDirty && dishScratch == flaggedDishes) return;
+    flaggedDishes.swap(dishScratch);
+    deadItemsDirty = false;
 
-    std::map<std::string, Texture2D> frostedEnergyTreatTextures;
-    frostedEnergyTreatTextures["default"] = LoadTexture("assets/FrostedEnergyTreat.png");
-    dishTextures["frosted energy treat"] = frostedEnergyTreatTextures;
+    flaggedItems.clear();
+    for (BaseItem* item : items) {
+        bool isIngredient = item->baseLayer != DrawLayer::Tools && !item->IsPlate();
+        flaggedItems.push_back(isIngredient ? item->GetType() : RecipeGraph::noItem);
+    }
+
+    recipes->FindDeadEnds(flaggedItems, flaggedDishes, deadEnds);
+    for (size_t i = 0; i < items.size(); i++) {
+        items[i]->deadEnd = deadEnds[i];
+    }
+}
+
+// Static method to unload every sound effect and its voices
+void BaseItem::UnloadStaticSounds()
+{
+    soundEffects.Unload();
+    stationSounds.fill(VoicePool::noEffect);
+}
+
+// Returns the texture set of a type, or an empty set if it has none
+const TextureSet& BaseItem::GetTextureSet(std::string_view type)
+{
+    static const TextureSet noTextures{};
+    size_t slot = ContentNames::Find(type);
+    return slot < textureSets.size() ? textureSets[slot] : noTextures;
+}
 
-    std::map<std::string, Texture2D> proteinVegMixTextures;
-    proteinVegMixTextures["default"] = LoadTexture("assets/ProteinVegMix.png");
-    dishTextures["protein veg mix"] = proteinVegMixTextures;
+// Loads the image a type is drawn with in one state, which joins its shared set once PackTextures has packed it
+void BaseItem::AddTexture(std::string_view type, ItemState state, const std::string& path)
+{
+    size_t slot = ContentNames::Find(type);
+    if (slot >= textureSets.size()) {
+        std::cerr << "No content slot for " << type << ", " << path << " was not loaded" << std::endl;
+        return;
+    }
 
-    std::map<std::string, Texture2D> icySweetMixTextures;
-    icySweetMixTextures["default"] = LoadTexture("assets/IcySweetMix.png");
-    dishTextures["icy sweet mix"] = icySweetMixTextures;
+    size_t sprite = atlas.Add(path);
+    if (sprite != TextureAtlas::npos) queuedTextures.push_back({ slot, state, sprite });
+}
 
+// Static method to pack every texture added so far into the atlas and give each its sprite
+void BaseItem::PackTextures()
+{
+    atlas.Build();
+    for (const QueuedTexture& queued : queuedTextures) {
+        textureSets[queued.slot][static_cast<size_t>(queued.state)] = atlas.GetSprite(queued.sprite);
+    }
+    queuedTextures.clear();
 }
 
-void BaseItem::PlaySoundEffect(const std::string& soundName)
+// The name of the item's type, for debugging and saving
+const std::string& BaseItem::GetTypeName() const
 {
-    PlaySound(soundEffects[soundName]);
+    static const std::string unknownName = "unknown";
+    RecipeGraph::ItemId type = GetType();
+    return type < recipes->GetIdCount() ? recipes->GetName(type) : unknownName;
 }
 
-void BaseItem::StopSoundEffect(const std::string& soundName)
+const Sprite& BaseItem::GetSprite() const
 {
-    StopSound(soundEffects[soundName]);
+    size_t index = GetIndex();
+    return textureSets[store.textureSets[index]][static_cast<size_t>(store.states[index])];
 }
 
-// Places a new item on a given item
+// Places an item on this one, recording this one as its parent so UpdateAll moves it along
 void BaseItem::AddItem(BaseItem* item)
 {
-    // If there is nothing in the first slot, place it there
-    if (itemsPlaced[0] == nullptr) {
-        itemsPlaced[0] = item;
+    if (item == nullptr) return;
+    size_t slot = PlaceInSlots(itemsPlaced, item);
+    size_t index = item->GetIndex();
+    store.parents[index] = handle;
+    store.parentSlots[index] = static_cast<std::uint8_t>(slot);
+    item->MoveToLayer(drawLayer == DrawLayer::Held ? DrawLayer::HeldPlaced : item->baseLayer);
+    item->StartStation(this, slot);
+}
+
+BaseItem* BaseItem::TakePlaced()
+{
+    BaseItem* item = TakeLastFromSlots(itemsPlaced);
+    if (item != nullptr) {
+        store.parents[item->GetIndex()] = ItemHandle{};
+        item->MoveToLayer(item->baseLayer);
+        item->StopStation();
     }
+    return item;
+}
 
-    // Otherwise place it in the second slot
-    else {
-        itemsPlaced[1] = item;
+void BaseItem::ClearItems()
+{
+    for (ItemHandle slot : itemsPlaced) {
+        if (BaseItem* item = Get(slot)) {
+            store.parents[item->GetIndex()] = ItemHandle{};
+            item->MoveToLayer(item->baseLayer);
+            item->StopStation();
+        }
     }
+    itemsPlaced.assign(slotCount, ItemHandle{});
 }
 
-// Static method to unload all static textures loaded by the Items class
-void BaseItem::UnloadStaticTextures()
+// Starts the timer of an item put on a station that works on it over time. Only the item in a station's first
+// slot is processed, and only if nothing has been done to it yet
+void BaseItem::StartStation(const BaseItem* station, size_t slot)
 {
-    for (auto& textureMap : dishTextures) {
-        for (auto& texturePair : textureMap.second) {
-            UnloadTexture(texturePair.second);
+    StopStation();
+    const StationInfo* info = station->GetStation();
+    if (info == nullptr || info->needsInteraction || slot != 0 || GetState() != ItemState::Default) return;
+    if (!ApplyTool(GetType(), station->GetType())) return;
+
+    stationTimer = stations.Schedule(info->duration, handle);
+    stationVoice = soundEffects.Play(GetStationSound(*info));
+}
+
+// Stops the item's station, and the sound it started, when it is taken off or destroyed
+void BaseItem::StopStation()
+{
+    stations.Cancel(stationTimer);
+    stationTimer = TimerHandle{};
+    soundEffects.Stop(stationVoice);
+    stationVoice = VoiceHandle{};
+}
+
+// Processes an item whose timer has fired. Items leaving their station cancel the timer, so the parent is still the
+// station, and the recipes are checked again in case they were reloaded while it was waiting
+void BaseItem::FinishStation()
+{
+    stationTimer = TimerHandle{};
+    BaseItem* station = Get(store.parents[GetIndex()]);
+    if (station == nullptr || GetState() != ItemState::Default) return;
+
+    if (const StationInfo* info = station->GetStation()) Process(station->GetType(), *info);
+}
+
+// Applies a station's tool input to the item, returning false if the recipes turn it into nothing
+bool BaseItem::Process(RecipeGraph::ItemId input, const StationInfo& station)
+{
+    std::optional<RecipeGraph::ItemId> processedType = ApplyTool(GetType(), input);
+    if (!processedType) return false;
+
+    SetState(station.result);
+    SetType(*processedType);
+    GameEvents::ItemProcessed(handle, *processedType);
+    return true;
+}
+
+// The station the item is, or nullptr if it is not a tool that works on items
+const StationInfo* BaseItem::GetStation() const
+{
+    RecipeGraph::ItemId type = GetType();
+    if (type == RecipeGraph::noItem) return nullptr;
+
+    for (size_t station = 0; station < stationCount; station++) {
+        if (stationInputs[station] == type) return &stationTable[station];
+    }
+    return nullptr;
+}
+
+// Places an item in the first empty slot and returns the slot, where a slot whose item was destroyed counts as empty
+size_t BaseItem::PlaceInSlots(std::vector<ItemHandle>& slots, BaseItem* item)
+{
+    for (size_t slot = 0; slot < slots.size(); slot++) {
+        if (Get(slots[slot]) == nullptr) {
+            slots[slot] = item->GetHandle();
+            return slot;
         }
     }
-    dishTextures.clear();
+
+    // Only reached if the recipes changed to smaller ones while items were placed
+    slots.push_back(item->GetHandle());
+    return slots.size() - 1;
+}
+
+// The item placed most recently, which is the one taken off first
+BaseItem* BaseItem::FindLastInSlots(const std::vector<ItemHandle>& slots)
+{
+    for (auto slot = slots.rbegin(); slot != slots.rend(); ++slot) {
+        if (BaseItem* item = Get(*slot)) return item;
+    }
+    return nullptr;
 }
 
-// Unloads textures used by a specific instance of the class
-void BaseItem::UnloadTextures()
+// Removes the item placed most recently and returns it, leaving anything else placed where it is
+BaseItem* BaseItem::TakeLastFromSlots(std::vector<ItemHandle>& slots)
 {
-    for (auto& texturePair : itemTextures) {
-        UnloadTexture(texturePair.second);
+    for (auto slot = slots.rbegin(); slot != slots.rend(); ++slot) {
+        if (BaseItem* item = Get(*slot)) {
+            *slot = ItemHandle{};
+            return item;
+        }
     }
-    itemTextures.clear();
+    return nullptr;
+}
+
+// Static method to unload the atlas every texture set is drawn from
+void BaseItem::UnloadStaticTextures()
+{
+    atlas.Unload();
+    queuedTextures.clear();
+    textureSets.clear();
 }
 
 
+// Processes the item on a station the player uses, such as a chopping board. Other stations run on their own
 void BaseItem::HandleCooking()
 {
-    if (GetType() == "chopping board") {
-        if (recipes.ApplyInputToNode(GetPlaced()->GetType(), "chopping board") == "NULL") return;
-        GetPlaced()->SetState("chopped");
-        GetPlaced()->SetType(recipes.ApplyInputToNode(GetPlaced()->GetType(), "chopping board"));
-        PlaySoundEffect("chopping");
-    }
+    const StationInfo* station = GetStation();
+    BaseItem* placed = GetPlaced();
+    if (station == nullptr || !station->needsInteraction || placed == nullptr) return;
+
+    if (placed->Process(GetType(), *station)) soundEffects.Play(GetStationSound(*station));
+}
+
+// Changes what the item is, keeping the kitchen hash in step
+void BaseItem::SetType(RecipeGraph::ItemId type)
+{
+    bool wasInKitchen = inKitchen;
+    LeaveKitchen();
+    store.types[GetIndex()] = type;
+    if (wasInKitchen) EnterKitchen();
+    deadItemsDirty = true;
+}
+
+// Adds the item to the kitchen hash, types the recipes do not know are tracked but never hashed
+void BaseItem::EnterKitchen()
+{
+    if (inKitchen) return;
+    inKitchen = true;
+    kitchenId = GetType();
+    if (kitchenId != RecipeGraph::noItem) kitchen.Add(kitchenId);
+}
+
+void BaseItem::LeaveKitchen()
+{
+    if (!inKitchen) return;
+    inKitchen = false;
+    if (kitchenId != RecipeGraph::noItem) kitchen.Remove(kitchenId);
 }
 
 // Removes the current item and/or anything placed on it
 void BaseItem::RemoveItems(bool removeSelf, bool removePlaced)
 {
     if (removeSelf) {
-        removeItem = true;  // Sets a flag to remove this item
+        LeaveKitchen();
+        GameEvents::ItemRemoved(handle);  // Destroyed once the frame's events are handled
     }
 
     if (removePlaced) {
-        for (auto item : itemsPlaced) {
-            if (item != nullptr)
+        for (ItemHandle slot : itemsPlaced) {
+            if (BaseItem* item = Get(slot))
                 item->RemoveItems();  // Removes any item placed
         }
         ClearItems();
     }
 }
 
-// Handles logic for combining two items
+// Handles logic for combining the placed items
 void BaseItem::CombineItems()
 {
-    if (itemsPlaced[0] == nullptr || itemsPlaced[1] == nullptr) return;  // If either item is empty, exit
+    std::optional<RecipeGraph::ItemId> combinedType = FindCombination(itemsPlaced);  // Find the result of combining the items
 
-    // Get the name of both items
-    std::string type1 = itemsPlaced[0]->GetType();
-    std::string type2 = itemsPlaced[1]->GetType();
-
-    std::string combinedType = recipes.FindCommonNode(type1, type2);  // Find the result of combining the two items
-
-    // If FindCommonNode returns NULL, the items cannot be combined
-    if (combinedType != "NULL") {
-        combineItems = true;
+    // If FindCombination returns nothing, the items do not make a recipe yet
+    if (combinedType) {
         RemoveItems(false);
         ClearItems();
-        BaseItem* newItem = CreateCombinedItem(combinedType);  // Creates a new object based on the result of combining the items
+        BaseItem* newItem = CreateCombinedItem(*combinedType);  // Creates a new object based on the result of combining the items
         newItem->SetDimensions(50.f, 50.f);
-        if (newItem) AddItem(newItem);  // If the new item as created successfully, place it on the current object
+        AddItem(newItem);  // Places the new item on the current object
+        GameEvents::ItemCombined(newItem->GetHandle(), *combinedType);
     }
 }
 
 // Creates a new object of a given type
-BaseItem* BaseItem::CreateCombinedItem(const std::string& type)
+BaseItem* BaseItem::CreateCombinedItem(RecipeGraph::ItemId type)
 {
-    return new Ingredient(dishTextures[type], type);
+    return Create<Ingredient>(type);
 }
 
-// Handles drawing and main logic for items
-void BaseItem::Tick(float deltaTime)
+// Draws the item where UpdateAll has moved it
+void BaseItem::Draw() const
 {
-    CombineItems();  // Checks if there are items that can be combined
-
-    // If the current item is a frying pan with something placed on it
-    if (itemType == "frying pan" && itemsPlaced[0] != nullptr) {
-        itemTimer += deltaTime;
+    size_t index = GetIndex();
+    Vector2 position = store.positions[index];
+    Vector2 size = store.sizes[index];
 
-        if (GetPlaced() != nullptr) {
-            // If the placed item can be fried, and 5 seconds have passed
-            if (itemTimer >= 5.f && GetPlaced()->CanFry(GetPlaced()->GetType())) {
-                // If the placed item has not been processed yet, cook it
-                if (GetPlaced()->GetState() == "default") {
-                    GetPlaced()->SetState("cooked");
-                    GetPlaced()->SetType(recipes.ApplyInputToNode(GetPlaced()->GetType(), "frying pan"));
-                    ResetTimer();
-                }
-            }
-            // If the item cannot be fried, reset the timer
-            else if (!GetPlaced()->CanFry(GetPlaced()->GetType())) ResetTimer();
-        }
-    }
-
-    // The selects the section of the texture to draw (the whole texture)
-    Rectangle source = { 0, 0, (float)GetTexture()[itemState].width, (float)GetTexture()[itemState].height};
+    // The sprite's page and the section of it the sprite is in
+    const Sprite& sprite = GetSprite();
 
     // The rect that determines the position and dimensions of the texture
     Rectangle dest = {
-        GetPos().x,
-        GetPos().y,
-        itemWidth,
-        itemHeight
+        position.x,
+        position.y,
+        size.x,
+        size.y
     };
 
     // What point on the texture is treated as the origin (the centre)
     Vector2 origin = {
-        (itemWidth) / 2.f,
-        (itemHeight) / 2.f
+        (size.x) / 2.f,
+        (size.y) / 2.f
     };
 
-    DrawTexturePro(GetTexture()[itemState], source, dest, origin, itemAngle, WHITE);
+    DrawTexturePro(sprite.texture, sprite.source, dest, origin, store.angles[index], WHITE);
+}
+
+// Runs the per-frame logic of every item as passes over the store, after counters and the player have placed the items they hold
+void BaseItem::UpdateAll(float deltaTime)
+{
+    // Combines what is placed on anything items can be placed on, which is never an ingredient. Combining adds the
+    // new item to the ingredient buckets, so the buckets are walked by index
+    for (DrawLayer layer : { DrawLayer::Tools, DrawLayer::Plates, DrawLayer::Held }) {
+        std::vector<BaseItem*>& bucket = layers[static_cast<size_t>(layer)];
+        for (size_t position = 0; position < bucket.size(); position++) bucket[position]->CombineItems();
+    }
+
+    const size_t itemCount = store.GetSize();
+
+    // Moves placed items to the item they are on, fanning out the ingredients of an unfinished recipe. Nothing is
+    // ever placed on an item that is itself placed on an item, so parents have already been moved this frame
+    for (size_t index = 0; index < itemCount; index++) {
+        size_t parent = store.GetPosition(store.parents[index]);
+        if (parent == ItemStore::npos) continue;
 
-    // Updates the position of any placed items to match itself
-    if (itemsPlaced[0] != nullptr) {
-        itemsPlaced[0]->SetPos(screenPos);
+        float offset = static_cast<float>(store.parentSlots[index]) * store.sizes[parent].x / 6.f;
+        store.positions[index] = Vector2{ store.positions[parent].x + offset, store.positions[parent].y - offset };
+    }
+
+    // Finishes the items whose stations are done, the timers of items already destroyed were cancelled with them
+    stations.Advance(deltaTime, [](ItemHandle item) {
+        if (BaseItem* finished = Get(item)) finished->FinishStation();
+    });
+}
+
+// Draws every item, a layer at a time
+void BaseItem::DrawAll()
+{
+    for (const std::vector<BaseItem*>& bucket : layers) {
+        for (const BaseItem* item : bucket) item->Draw();
+    }
+}
+
+// Adds the item to the end of a layer's bucket
+void BaseItem::JoinLayer(DrawLayer layer)
+{
+    std::vector<BaseItem*>& bucket = layers[static_cast<size_t>(layer)];
+    drawLayer = layer;
+    layerPosition = static_cast<std::uint32_t>(bucket.size());
+    bucket.push_back(this);
+}
+
+// Takes the item out of its layer's bucket, moving the last item in the bucket into its place
+void BaseItem::LeaveLayer()
+{
+    std::vector<BaseItem*>& bucket = layers[static_cast<size_t>(drawLayer)];
+    bucket[layerPosition] = bucket.back();
+    bucket[layerPosition]->layerPosition = layerPosition;
+    bucket.pop_back();
+}
+
+void BaseItem::MoveToLayer(DrawLayer layer)
+{
+    if (layer == drawLayer) return;
+    LeaveLayer();
+    JoinLayer(layer);
+}
+
+// Moves a picked up item and whatever is on it over everything else, or back to their own layers when put down
+void BaseItem::SetHeld(bool held)
+{
+    MoveToLayer(held ? DrawLayer::Held : baseLayer);
+    for (ItemHandle slot : itemsPlaced) {
+        if (BaseItem* item = Get(slot)) item->MoveToLayer(held ? DrawLayer::HeldPlaced : item->baseLayer);
     }
 }
 
 // Constructor for the Plate subclass
-Plate::Plate(const std::map<std::string, Texture2D>& textures, float width, float height) :
-    BaseItem(textures, "plate")
+Plate::Plate(float width, float height) :
+    BaseItem(plateType, DrawLayer::Plates)
 {
     if (width != 0.f) SetWidth(width);
     if (height != 0.f) SetHeight(height);
 }
 
 // Checks if an item can be placed on a given plate
-bool Plate::CanPlace(const std::string& type) const
+bool Plate::CanPlace(RecipeGraph::ItemId type) const
 {
     // If the item being placed is not a plate and the plate is empty,
     // or the item being placed is compatible with what is already placed
-    if (type != "plate") {
-        if (itemsPlaced[0] == nullptr) return 1;
-        else {
-            if (recipes.FindCommonNode(GetPlaced()->GetType(), type) != "NULL" && type != itemsPlaced[0]->GetType()) return 1;
-        }
+    if (type != plateType) {
+        if (GetPlaced() == nullptr) return 1;
+        else if (CanAddIngredient(itemsPlaced, type)) return 1;
     }
 
     return 0;
 }
 
 // Constructor for the Ingredient subclass
-Ingredient::Ingredient(std::map<std::string, Texture2D> textures, std::string type, float width, float height) :
-    BaseItem(textures, type)
+Ingredient::Ingredient(RecipeGraph::ItemId type, float width, float height) :
+    BaseItem(type, DrawLayer::Ingredients)
 {
     if (width != 0.f) SetWidth(width);
     if (height != 0.f) SetHeight(height);
+    EnterKitchen();
 }
 
 // Checks if an item can be chopped
-bool Ingredient::CanChop(const std::string& type) const
+bool Ingredient::CanChop(RecipeGraph::ItemId type) const
 {
     // If applying the chopping board input to the item yields a valid result, it can be chopped
-    if (recipes.ApplyInputToNode(type, "chopping board") != "NULL") return true;
+    if (ApplyTool(type, GetStationInput(Station::ChoppingBoard))) return true;
     return false;
 }
 
 // Checks if an item can be fried
-bool Ingredient::CanFry(const std::string& type) const
+bool Ingredient::CanFry(RecipeGraph::ItemId type) const
 {
     // If applying the frying pan input to the item yields a valid result, it can be fried
-    if (recipes.ApplyInputToNode(type, "frying pan") != "NULL") return true;
+    if (ApplyTool(type, GetStationInput(Station::FryingPan))) return true;
     return false;
 }
 
 // Checks if an item can be boiled
-bool Ingredient::CanBoil(const std::string& type) const
+bool Ingredient::CanBoil(RecipeGraph::ItemId type) const
 {
     // If applying the saucepan input to the item yields a valid result, it can be boiled
-    if (recipes.ApplyInputToNode(type, "saucepan") != "NULL") return true;
+    if (ApplyTool(type, GetStationInput(Station::Saucepan))) return true;
     return false;
 }
 
 // Constructor for the Tool subclass
-Tool::Tool(const std::map<std::string, Texture2D>& textures, const std::string& type, float width, float height) :
-    BaseItem(textures, type) 
+Tool::Tool(const std::string& type, float width, float height) :
+    BaseItem(GetTypeId(type), DrawLayer::Tools)
 {
     if (width != 0.f) SetWidth(width);
     if (height != 0.f) SetHeight(height);
-
-    if (type == "chopping board") {
-        itemFilter = {"tomato"};
-    }
-    if (type == "frying pan") {
-        itemFilter = { "patty", "cooked patty" };
-    }
 }
 
-bool Tool::CanPlace(const std::string& type) const
+bool Tool::CanPlace(RecipeGraph::ItemId type) const
 {   
-    if (itemsPlaced[0] != nullptr) return 0;
-    else if (recipes.ApplyInputToNode(type, GetType()) != "NULL") return 1;
+    if (GetPlaced() != nullptr) return 0;
+
+    if (ApplyTool(type, GetType())) return 1;
     return 0;
 }
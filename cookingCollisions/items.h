@@ -5,126 +5,272 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iostream>
-#include <map>
+#include <memory>
 #include "config.h"
 #include "recipeGraph.h"
+#include "frozenRecipeGraph.h"
+#include "shippedRecipes.h"
+#include "contentNames.h"
+#include "recipePlanner.h"
+#include "objectPool.h"
+#include "itemStore.h"
+#include "gameEvents.h"
+#include "timerWheel.h"
+#include "stations.h"
+#include "voicePool.h"
+#include "textureAtlas.h"
 
+class Order;
+class BaseItem;
+class Plate;
+class Ingredient;
+class Tool;
+
+// Every item is made in this pool, so removed items give their memory back for the next ones
+using ItemPool = ObjectPool<BaseItem, Plate, Ingredient, Tool>;
+
+// The sprite for each state of an item, packed once per type and shared by every item of that type
+using TextureSet = std::array<Sprite, itemStateCount>;
+
+// The buckets items are drawn from, in the order they are drawn. Counters are drawn before every layer and the HUD
+// after, so only items have buckets
+enum class DrawLayer : std::uint8_t {
+	Tools,
+	Plates,
+	Ingredients,
+	Held,
+	HeldPlaced  // Whatever is on the held item, drawn over it
+};
+
+constexpr size_t drawLayerCount = 5;
+
+// Item types are IDs interned by the recipe graph, which keeps every name it has seen, so an item's type never
+// needs a string. The names are only looked up for debugging and for saving.
+// What an item needs each frame is kept in the item store rather than in the item, and UpdateAll combines and moves
+// placed items as passes over it. Items on stations wait on a timer wheel instead, so idle stations cost nothing
 class BaseItem
 {
 public:
-	BaseItem(const std::map<std::string, Texture2D>& textures, std::string type): itemTextures(textures), itemType(type) {}
-	virtual ~BaseItem() = default;
+	BaseItem(RecipeGraph::ItemId type, DrawLayer layer);
+	virtual ~BaseItem();
 	static void SetupClass();
 
-	void Tick(float deltaTime);
+	template<typename T, typename... Args>
+	static T* Create(Args&&... args);
+	static void Destroy(BaseItem* item);
+	static void DestroyAll();
+	static BaseItem* Get(ItemHandle handle) { return store.Find(handle); }
+	static const std::vector<BaseItem*>& GetLiveItems() { return store.GetOwners(); }
+	static void UpdateAll(float deltaTime);
+	static void DrawAll();
+
+	// Slots of placed items, shared with counter units
+	static size_t PlaceInSlots(std::vector<ItemHandle>& slots, BaseItem* item);
+	static BaseItem* FindLastInSlots(const std::vector<ItemHandle>& slots);
+	static BaseItem* TakeLastFromSlots(std::vector<ItemHandle>& slots);
+
+	void Draw() const;
 	void AddItem(BaseItem* item);
-	void ClearItems() { itemsPlaced = { nullptr, nullptr }; }
-	void ClearTemps() { tempItems = { nullptr, nullptr }; }
-	void ResetTimer() { itemTimer = 0.f; }
+	BaseItem* TakePlaced();
+	void ClearItems();
+
+	static MultisetTable::Match MatchIngredients(const std::vector<RecipeGraph::ItemId>& ingredients);
+	static bool CanAddIngredient(const std::vector<ItemHandle>& placed, RecipeGraph::ItemId type);
+	static std::optional<RecipeGraph::ItemId> FindCombination(const std::vector<ItemHandle>& placed);
+	static std::optional<RecipeGraph::ItemId> ApplyTool(RecipeGraph::ItemId item, RecipeGraph::ItemId tool);
 
-	static void PlaySoundEffect(const std::string& soundName);
-	static void StopSoundEffect(const std::string& soundName);
+	static void UseRecipes(std::shared_ptr<const FrozenRecipeGraph> snapshot);
+	static bool ReloadRecipes();
+	static const FrozenRecipeGraph& GetRecipes() { return *recipes; }
+	static RecipeGraph::ItemId GetTypeId(const std::string& name) { return recipes->GetId(name).value_or(RecipeGraph::noItem); }
+	static void FlagDeadItems(const std::vector<BaseItem*>& items, const std::vector<Order*>& orders);
+
+	static const RecipePlanner::StateHash& GetKitchen() { return kitchen; }
+
+	static VoicePool& GetSoundEffects() { return soundEffects; }
+	static void UnloadStaticSounds();
 
 	virtual bool CanPickup() const = 0;
-	virtual bool CanPlace(const std::string& type) const = 0;
+	virtual bool CanPlace(RecipeGraph::ItemId type) const = 0;
 
-	virtual bool CanChop(const std::string& type) const { return 0; }
-	virtual bool CanFry(const std::string& type) const { return 0; }
-	virtual bool CanBoil(const std::string& type) const { return 0; }
+	virtual bool CanChop(RecipeGraph::ItemId type) const { return 0; }
+	virtual bool CanFry(RecipeGraph::ItemId type) const { return 0; }
+	virtual bool CanBoil(RecipeGraph::ItemId type) const { return 0; }
 
 	void HandleCooking();
 	void RemoveItems(bool removeSelf = true, bool removePlaced = true);
 	void CombineItems();
-	BaseItem* CreateCombinedItem(const std::string& type);
-	void ResetFlags() { removeItem = false; combineItems = false; serveItem = false; }
-	
+	void SetHeld(bool held);
+	BaseItem* CreateCombinedItem(RecipeGraph::ItemId type);
 
-	static Texture2D LoadTexture(std::string path);
+	static void AddTexture(std::string_view type, ItemState state, const std::string& path);
+	static void PackTextures();
 	static void UnloadStaticTextures();
-	void UnloadTextures();
 
 
 	// Getters
-	Vector2 GetPos() const { return screenPos;  }
-	std::string GetType() const { return itemType; }
-	std::string GetState() const { return itemState; }
-	std::map<std::string, Texture2D> GetTexture() const { return itemTextures; }
-	BaseItem* GetPlaced() const { return itemsPlaced[0];  }
-	std::vector<BaseItem*> GetItems() const { return itemsPlaced; }
-	std::vector<BaseItem*> GetTemps() const { return tempItems; }
-	std::vector<float> GetDimensions() const { return std::vector<float>{itemWidth, itemHeight}; }
-	bool GetCombine() { return combineItems; }
-	bool GetRemove() { return removeItem; }
-	bool GetServing() { return serveItem; }
-	float GetTime() { return itemTimer; }
-	static std::unordered_map<std::string, std::map<std::string, Texture2D>> GetDishTextures() { return dishTextures; }
+	Vector2 GetPos() const { return store.positions[GetIndex()]; }
+	RecipeGraph::ItemId GetType() const { return store.types[GetIndex()]; }
+	const std::string& GetTypeName() const;
+	ItemState GetState() const { return store.states[GetIndex()]; }
+	const Sprite& GetSprite() const;
+	bool IsPlate() const { return GetType() == plateType; }
+	const StationInfo* GetStation() const;
+	bool IsStation() const { return GetStation() != nullptr; }
+	ItemHandle GetHandle() const { return handle; }
+	BaseItem* GetPlaced() const { return Get(itemsPlaced[0]); }
+	BaseItem* GetLastPlaced() const { return FindLastInSlots(itemsPlaced); }
+	const std::vector<ItemHandle>& GetItems() const { return itemsPlaced; }
+	Vector2 GetDimensions() const { return store.sizes[GetIndex()]; }
+	bool GetDeadEnd() const { return deadEnd; }
+	static const std::vector<TextureSet>& GetTextureSets() { return textureSets; }
+	static const TextureSet& GetTextureSet(std::string_view type);
+	static size_t GetSlotCount() { return slotCount; }
 
 	// Setters
-	void SetState(const std::string& state) { itemState = state; }
-	void SetType(const std::string& type) { itemType = type; }
+	void SetState(ItemState state) { store.states[GetIndex()] = state; }
+	void SetType(RecipeGraph::ItemId type);
 
-	void SetPos(const Vector2& pos) { screenPos = pos; }
-	void MovePos(const Vector2& pos) { screenPos = Vector2Add(screenPos, pos); }
-	void SetRot(float angle) { itemAngle = angle; }
-	void SetDimensions(float width, float height) { itemWidth = width * static_cast<float>(winWidth) / 800.f; itemHeight = height * static_cast<float>(winWidth) / 800.f; }
-	void SetWidth(float width) { itemWidth = width * static_cast<float>(winWidth) / 800.f; }
-	void SetHeight(float height) { itemHeight = height * static_cast<float>(winWidth) / 800.f; }
-	void SetServing(bool serving) { serveItem = serving; }
+	void SetPos(const Vector2& pos) { store.positions[GetIndex()] = pos; }
+	void MovePos(const Vector2& pos) { Vector2& position = store.positions[GetIndex()]; position = Vector2Add(position, pos); }
+	void SetRot(float angle) { store.angles[GetIndex()] = angle; }
+	void SetDimensions(float width, float height) { store.sizes[GetIndex()] = { width * static_cast<float>(winWidth) / 800.f, height * static_cast<float>(winWidth) / 800.f }; }
+	void SetWidth(float width) { store.sizes[GetIndex()].x = width * static_cast<float>(winWidth) / 800.f; }
+	void SetHeight(float height) { store.sizes[GetIndex()].y = height * static_cast<float>(winWidth) / 800.f; }
 
-	static void SetOrderedDishes(const std::vector<std::string>& dishes) { orderedDishes = dishes; }
+	static void SetOrderedDishes(const std::vector<RecipeGraph::ItemId>& dishes) { orderedDishes = dishes; }
 
 protected:
-	std::vector<std::string> itemFilter;
-	std::vector<BaseItem*> itemsPlaced = { nullptr, nullptr };
-	std::vector<BaseItem*> tempItems = { nullptr, nullptr };
+	std::vector<ItemHandle> itemsPlaced = std::vector<ItemHandle>(slotCount);
+
+	static std::vector<TextureSet> textureSets;  // Indexed by content slot
 
-	static std::unordered_map<std::string, std::map<std::string, Texture2D>> dishTextures;
-	static RecipeGraph& recipes;
-	static std::vector<std::string> orderedDishes;
-	static std::unordered_map<std::string, Sound> soundEffects;
+	// Every item texture is a sprite in the atlas, added textures wait here until PackTextures packs them
+	struct QueuedTexture {
+		size_t slot;
+		ItemState state;
+		size_t sprite;
+	};
+	static TextureAtlas atlas;
+	static std::vector<QueuedTexture> queuedTextures;
+	static thread_local std::shared_ptr<const FrozenRecipeGraph> recipes;
+	static std::vector<RecipeGraph::ItemId> orderedDishes;
+	// Only the thread that runs SetupClass loads sounds. Simulations on other threads have empty pools, which play nothing
+	static thread_local VoicePool soundEffects;
+	static thread_local std::array<VoicePool::EffectId, stationCount> stationSounds;  // Resolved once the effects are loaded, indexed like the station table
+	static VoicePool::EffectId GetStationSound(const StationInfo& station) { return stationSounds[&station - stationTable.data()]; }
+
+	// IDs of the stations' tool inputs in the recipes in use, resolved by UseRecipes and indexed like the station table
+	static thread_local std::array<RecipeGraph::ItemId, stationCount> stationInputs;
+	static RecipeGraph::ItemId GetStationInput(Station station) { return stationInputs[static_cast<size_t>(station)]; }
+	static thread_local RecipeGraph::ItemId plateType;  // Interned next to the recipes, which never use it
+	static thread_local size_t slotCount;  // Enough room for the largest recipe, set by UseRecipes
+	static thread_local std::vector<RecipeGraph::ItemId> ingredientScratch;  // Sorted IDs of placed items, reserved to slotCount so matching never allocates
+
+	// What FlagDeadItems last worked from. Items are flagged again only when one is made, removed or changes type,
+	// the recipes change or the ordered dishes do, and the buffers are kept so flagging never allocates
+	static thread_local bool deadItemsDirty;
+	static thread_local std::vector<RecipeGraph::ItemId> flaggedDishes;
+	static thread_local std::vector<RecipeGraph::ItemId> dishScratch;
+	static thread_local std::vector<RecipeGraph::ItemId> flaggedItems;
+	static thread_local std::vector<bool> deadEnds;
+
+	// Every ingredient in play, wherever it is. Moving an item leaves the hash as it is, so a planner asked about
+	// the kitchen every frame only searches again when an ingredient appears, is used up or changes type
+	static thread_local RecipePlanner::StateHash kitchen;
+	void EnterKitchen();
+	void LeaveKitchen();
+
+	// Every live item is in the bucket of the layer it is drawn in, and moves between buckets only when it is
+	// picked up, put down or placed on something held
+	static thread_local std::array<std::vector<BaseItem*>, drawLayerCount> layers;
+	void JoinLayer(DrawLayer layer);
+	void LeaveLayer();
+	void MoveToLayer(DrawLayer layer);
+
+	static ItemPool& GetPool();
+	static thread_local ItemStore store;  // The per-frame data of every live item on the thread
+	size_t GetIndex() const { return store.GetPosition(handle); }
+
+	// When each item being worked on by a station is done, advanced by UpdateAll
+	static thread_local TimerWheel<ItemHandle> stations;
+	void StartStation(const BaseItem* station, size_t slot);
+	void StopStation();
+	void FinishStation();
+	bool Process(RecipeGraph::ItemId input, const StationInfo& station);
 
 private:
-	bool combineItems = false;
-	bool removeItem = false;
-	bool serveItem = false;
-	std::map<std::string, Texture2D> itemTextures;
-	std::string itemType;
-	std::string itemState = "default";
-	float itemTimer = 0.f;
-
-	Vector2 screenPos{};
-	float itemWidth = 75.f * static_cast<float>(winWidth) / 800.f;
-	float itemHeight = 75.f * static_cast<float>(winWidth) / 800.f;
-	float itemAngle = 0.f;
+	ItemHandle handle;  // The item's entries in the store, added when it is constructed
+	TimerHandle stationTimer;  // Pending while a station is working on the item
+	VoiceHandle stationVoice;  // The sound the item's station started, stopped if the item leaves it
+	DrawLayer baseLayer;  // The layer the item is drawn in when it is not held
+	DrawLayer drawLayer;
+	std::uint32_t layerPosition = 0;  // Where the item is in its layer's bucket
+	bool deadEnd = false;  // Set by FlagDeadItems when the item can no longer become any ordered dish
+	bool inKitchen = false;
+	RecipeGraph::ItemId kitchenId = RecipeGraph::noItem;  // The ID the item was added to the kitchen hash with
 };
 
+// Finds what a set of items makes from their sorted IDs, folding completed pairs to a table lookup when the shipped recipes are compiled in
+inline MultisetTable::Match BaseItem::MatchIngredients(const std::vector<RecipeGraph::ItemId>& ingredients)
+{
+	if constexpr (staticRecipes) {
+		if (ingredients.size() == 2 && ingredients[0] != ingredients[1]) {
+			RecipeGraph::ItemId result = ShippedRecipes::graph.FindCommonNode(ingredients[0], ingredients[1]);
+			if (result != ShippedRecipes::graph.noItem) return { true, result };
+		}
+	}
+	return recipes->MatchRecipe(ingredients.data(), ingredients.size());
+}
+
+// Finds what an item turns into when a tool is applied to it, folding to a table lookup when the shipped recipes are compiled in
+inline std::optional<RecipeGraph::ItemId> BaseItem::ApplyTool(RecipeGraph::ItemId item, RecipeGraph::ItemId tool)
+{
+	if constexpr (staticRecipes) {
+		RecipeGraph::ItemId result = ShippedRecipes::graph.ApplyInputToNode(item, tool);
+		if (result == ShippedRecipes::graph.noItem) return std::nullopt;
+		return result;
+	}
+	else return recipes->ApplyInputToNode(item, tool);
+}
+
 class Plate : public BaseItem
 {
 public:
-	Plate(const std::map<std::string, Texture2D>& textures, float width = 0.f, float height = 0.f);
+	Plate(float width = 0.f, float height = 0.f);
 
 	bool CanPickup() const override { return 1; }
-	bool CanPlace(const std::string& type) const override;
+	bool CanPlace(RecipeGraph::ItemId type) const override;
 };
 
 class Ingredient : public BaseItem
 {
 public:
-	Ingredient(std::map<std::string, Texture2D> textures, std::string type, float width = 0.f, float height = 0.f);
+	Ingredient(RecipeGraph::ItemId type, float width = 0.f, float height = 0.f);
+	Ingredient(const std::string& type, float width = 0.f, float height = 0.f) : Ingredient(GetTypeId(type), width, height) {}
 
 	bool CanPickup() const override { return 1; }
-	bool CanPlace(const std::string& type) const override { return 0; }
-	bool CanChop(const std::string& type) const override;
-	bool CanFry(const std::string& type) const override;
-	bool CanBoil(const std::string& type) const override;
+	bool CanPlace(RecipeGraph::ItemId type) const override { return 0; }
+	bool CanChop(RecipeGraph::ItemId type) const override;
+	bool CanFry(RecipeGraph::ItemId type) const override;
+	bool CanBoil(RecipeGraph::ItemId type) const override;
 };
 
 class Tool : public BaseItem
 {
 public:
-	Tool(const std::map<std::string, Texture2D>& textures, const std::string& type, float width = 0.f, float height = 0.f);
+	Tool(const std::string& type, float width = 0.f, float height = 0.f);
 
 	bool CanPickup() const override { return 0; }
-	bool CanPlace(const std::string& type) const override;
+	bool CanPlace(RecipeGraph::ItemId type) const override;
 };
+
+// Makes an item in the pool, which only Destroy or DestroyAll give back. The item adds itself to the store as it is constructed
+template<typename T, typename... Args>
+inline T* BaseItem::Create(Args&&... args)
+{
+	return GetPool().template Create<T>(std::forward<Args>(args)...);
+}
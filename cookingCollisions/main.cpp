@@ -1,9 +1,8 @@
 #include "raylib.h"
 #include <sstream>
-#include <map>
-#include <unordered_map>
 #include <random>
 #include <cmath>
+#include <algorithm>
 #include "config.h"
 #include "player.h"
 #include "counter.h"
@@ -11,83 +10,59 @@
 #include "order.h"
 #include "button.h"
 #include "recipeBook.h"
+#include "fileWatcher.h"
+#include "gameEvents.h"
 
-// Handles events related to dishes, such as removing, combining, and serving items
-std::unordered_map<std::string, int> handleEvents(std::vector<BaseItem*>& items, const std::vector<std::string>& orderedDishes,
-    std::vector<Order*>& orders, const std::vector<CounterUnit*> units, float& gameTimer, int& score, bool isTutorial,
-    int& ordersDelivered)
+// Handles the events of the frame, such as removing items, serving dishes and orders running out of time
+void handleEvents(std::vector<Order*>& orders, float& gameTimer, int& score, bool isTutorial, int& ordersDelivered)
 {
-    int newItemPlate = -1;  // Initialises the new item variable to null
-    int newItemUnit = -1;
-
-    // Iterates through every currently existing item
-    for (auto it = items.begin(); it != items.end();) {
-        BaseItem* currentItem = *it;  // Gets the current item
-
-        // Ensures the current item is a valid pointer
-        if (currentItem != nullptr) {
-            std::vector<BaseItem*> placedItems = currentItem->GetTemps();  // Gets the items to combine
-
-            // If the current item is flagged to remove
-            if (currentItem->GetRemove()) {
-                it = items.erase(it);  // Remove the item from the vector
-                continue;  // Moves on to the next item
-            }
-
-            // If the current item is flagged to combine items
-            else if (currentItem->GetCombine()) {
-                newItemPlate = static_cast<int>(std::distance(items.begin(), it));  // Gets the index of the current item
-            }
-
-            // If the current item is flagged to serve
-            else if (currentItem->GetServing()) {
-                std::string dishToServe = currentItem->GetPlaced()->GetType();
-                bool found = false;
-                int index = 0;
-
-                // A linear search through all ordered dishes
-                while (!found && index < orderedDishes.size()) {
-                    // If the current ordered dish is the same as the current item
-                    if (orderedDishes[index] == dishToServe) {
-                        orders.erase(orders.begin() + index);  // Removes the order from the list
-                        found = true;
-
-                        // Adds time and score
-                        if (!isTutorial) {
-                            ordersDelivered++;
-                            gameTimer += 20.f;
-                            score += 10;
-                            if (gameTimer > 150.f) gameTimer = 150.f; // Ensures the time does not go above 180 seconds
-                        }
-                    }
-
-                    // Otherwise increments the index
-                    else index++;
+    GameEvents::Drain([&](const GameEvent& event) {
+        switch (event.type) {
+        // Items are only flagged for removal during the frame, as they may still be drawn or held
+        case GameEvent::Type::ItemRemoved:
+            BaseItem::Destroy(BaseItem::Get(event.item));  // Gives its memory back to the pool, items already destroyed are null
+            break;
+
+        case GameEvent::Type::DishServed: {
+            // A linear search for the first order of the dish served
+            auto order = std::find_if(orders.begin(), orders.end(), [&](const Order* order) { return order->GetDishId() == event.dish; });
+
+            if (order != orders.end()) {
+                orders.erase(order);  // Removes the order from the list
+
+                // Adds time and score
+                if (!isTutorial) {
+                    ordersDelivered++;
+                    gameTimer += 20.f;
+                    score += 10;
+                    if (gameTimer > 150.f) gameTimer = 150.f; // Ensures the time does not go above 180 seconds
                 }
-                if (!found && !isTutorial) gameTimer -= 15.f; // Time penalty
             }
-            ++it;
+            else if (!isTutorial) gameTimer -= 15.f; // Time penalty
+            break;
         }
-    }
 
-    // Iterates through all units and checks for combinations
-    for (auto it = units.begin(); it != units.end();) {
-        CounterUnit* currentUnit = *it;
-
-        if (currentUnit != nullptr) {
-            if (currentUnit->GetCombine()) {
-                newItemUnit = static_cast<int>(std::distance(units.begin(), it));
+        // If the timer for an order runs out, impose time penalty
+        case GameEvent::Type::OrderExpired: {
+            auto order = std::find(orders.begin(), orders.end(), event.order);
+            if (order != orders.end()) {
+                orders.erase(order);
+                if (!isTutorial) gameTimer -= 15.f;
             }
-            it++;
+            break;
         }
-    }
 
-    return { {"plate", newItemPlate}, {"unit", newItemUnit} };
+        // The combined item is already placed where its ingredients were, and a processed item stays on its station
+        case GameEvent::Type::ItemCombined:
+        case GameEvent::Type::ItemProcessed:
+            break;
+        }
+    });
 }
 
 // Handles drawing and some logic during the main sequence
 void Tick(float deltaTime, int& score, float globalTime, float& gameTimer, float& timeSinceOrder, float& timeToNext,
-    Player& player, Counter& counter, std::vector<BaseItem*>& items, std::vector<Order*>& orders, RecipeBook& recipeBook,
+    Player& player, Counter& counter, std::vector<Order*>& orders, RecipeBook& recipeBook,
     std::vector<std::string>& tutorialOrders, int& ordersDelivered, std::vector<int>& orderLevels)
 {
     BeginDrawing();
@@ -103,62 +78,25 @@ void Tick(float deltaTime, int& score, float globalTime, float& gameTimer, float
     player.HandleSelect(unitPointers);
     player.HandleItems(unitPointers);
 
-    // Creates a vector of the names of all ordered dishes
-    std::vector<std::string> orderedDishes;
+    // Creates a vector of the IDs of all ordered dishes
+    std::vector<RecipeGraph::ItemId> orderedDishes;
     for (auto order : orders) {
-        orderedDishes.push_back(order->GetDish());
+        orderedDishes.push_back(order->GetDishId());
     }
     BaseItem::SetOrderedDishes(orderedDishes);
+    const std::vector<BaseItem*>& items = BaseItem::GetLiveItems();
+    BaseItem::FlagDeadItems(items, orders);
 
-    std::vector<BaseItem*> firstItems;
-    std::vector<BaseItem*> otherItems;
-
-    // Defines the order of drawing items
-    for (BaseItem* item : items) {
-        if (dynamic_cast<Plate*>(item)) {
-            firstItems.push_back(item);
-        }
-        else {
-            otherItems.push_back(item);
-        }
-    }
-    
-    // Draws all items
-    for (BaseItem* item : firstItems) {
-        item->Tick(deltaTime);
-    }
-    for (BaseItem* item : otherItems) {
-        item->Tick(deltaTime);
-    }
+    // Combines and moves placed items for every item at once and finishes anything stations are done with
+    BaseItem::UpdateAll(deltaTime);
 
-    std::unordered_map<std::string, int> newItems = handleEvents(items, orderedDishes, orders,
-                                                                counter.GetUnitsPointers(), gameTimer, score,
-                                                                tutorialOrders.size(), ordersDelivered);
-    
-    // If there is a new item, add the new item to the list
-    if (newItems["plate"] != -1) {
-        Plate* plate = dynamic_cast<Plate*>(items[newItems["plate"]]);
-        if (plate) {
-            items.push_back(plate->GetPlaced());
-        }
-    }
+    // Draws all items a layer at a time, so plates and tools are under what is placed on them
+    BaseItem::DrawAll();
 
-    // Handles combined items on plates
-    if (newItems["unit"] != -1) {
-        items.push_back(counter.GetUnitsPointers()[newItems["unit"]]->GetPlaced());
-    }
+    handleEvents(orders, gameTimer, score, tutorialOrders.size(), ordersDelivered);
 
     player.Draw();
 
-    // Resets flags for all items and units
-    for (BaseItem* item : items) {
-        item->ResetFlags();
-    }
-
-    for (CounterUnit* unit : counter.GetUnitsPointers()) {
-        unit->ResetFlags();
-    }
-
     DrawText("Orders ->", 140, 5, 20, BLACK);
 
     // Draws tutorial text
@@ -203,19 +141,6 @@ void Tick(float deltaTime, int& score, float globalTime, float& gameTimer, float
         orderLevels.erase(orderLevels.begin());
     }
 
-    // Handles general logic for orders
-    for (auto it = orders.begin(); it != orders.end();) {
-        Order* currentItem = *it;
-
-        // If the timer for an order runs out, impose time penalty
-        if (currentItem->GetTime() <= 0.f) {
-            it = orders.erase(it);
-            if (!tutorialOrders.size())
-            gameTimer -= 15.f;
-        }
-        else ++it;
-    }
-
     // Resets the time, and determines the time until the next order appears
     if (timeSinceOrder >= timeToNext) {
         if (orders.size() < 5) {
@@ -357,6 +282,9 @@ int main() {
 
     Player player({ static_cast<float>(winWidth) / 2.f, static_cast<float>(winHeight) / 2.f });
 
+    // Loads the recipes and content names before any order looks its dish up in them
+    BaseItem::SetupClass();
+
     Order::AddType({ "sweet crystal", "spice particle", "energy particle", "liquid essence", "protein orb",
                     "vegetable core", "aroma sphere", "cooling shard", "caramel essence", "frozen spice mix",
                     "protein veg mix", "spiced liquid", "sugar shards"});
@@ -368,105 +296,46 @@ int main() {
     orders.push_back(new Order(tutorialOrders[0]));  // Initially adds an order to the queue
     tutorialOrders.erase(tutorialOrders.begin());
 
-    BaseItem::SetupClass();
-
-
-    // Sets up all textures to be used
+    // Loads the texture sets of the tools and sources, which items share by the content slot of their type
     // =============================================================================================
-    std::unordered_map<std::string, std::map<std::string, Texture2D>> textures;
-    std::vector<Texture2D> recipeTextures;
-    std::unordered_map<std::string, Texture2D> orderTextures;
-
-    std::map<std::string, Texture2D> nullTextures;
-    nullTextures["default"] = BaseItem::LoadTexture("assets/NULL.png");
-    textures["null"] = nullTextures;
-
-    std::map<std::string, Texture2D> choppingBoardTextures;
-    choppingBoardTextures["default"] = BaseItem::LoadTexture("assets/ChoppingBoard.png");
-    textures["chopping board"] = choppingBoardTextures;
-
-    std::map<std::string, Texture2D> fryingPanTextures;
-    fryingPanTextures["default"] = BaseItem::LoadTexture("assets/FryingPan.png");
-    textures["frying pan"] = fryingPanTextures;
-
-    std::map<std::string, Texture2D> plateTextures;
-    plateTextures["default"] = BaseItem::LoadTexture("assets/Plate.png");
-    textures["plate"] = plateTextures;
-
-    std::map<std::string, Texture2D> sweetCrystalTextures;
-    sweetCrystalTextures["default"] = BaseItem::LoadTexture("assets/SweetCrystal.png");
-    sweetCrystalTextures["cooked"] = BaseItem::LoadTexture("assets/CaramelEssence.png");
-    sweetCrystalTextures["chopped"] = BaseItem::LoadTexture("assets/SugarShards.png");
-    textures["sweet crystal"] = sweetCrystalTextures;
-
-    std::map<std::string, Texture2D> spiceParticleTextures;
-    spiceParticleTextures["default"] = BaseItem::LoadTexture("assets/SpiceParticle.png");
-    textures["spice particle"] = spiceParticleTextures;
-
-    std::map<std::string, Texture2D> energyParticleTextures;
-    energyParticleTextures["default"] = BaseItem::LoadTexture("assets/EnergyParticle.png");
-    textures["energy particle"] = energyParticleTextures;
-
-    std::map<std::string, Texture2D> liquidEssenceTextures;
-    liquidEssenceTextures["default"] = BaseItem::LoadTexture("assets/LiquidEssence.png");
-    textures["liquid essence"] = liquidEssenceTextures;
-
-    std::map<std::string, Texture2D> proteinOrbTextures;
-    proteinOrbTextures["default"] = BaseItem::LoadTexture("assets/ProteinOrb.png");
-    textures["protein orb"] = proteinOrbTextures;
-
-    std::map<std::string, Texture2D> vegetableCoreTextures;
-    vegetableCoreTextures["default"] = BaseItem::LoadTexture("assets/VegetableCore.png");
-    textures["vegetable core"] = vegetableCoreTextures;
-
-    std::map<std::string, Texture2D> aromaSphereTextures;
-    aromaSphereTextures["default"] = BaseItem::LoadTexture("assets/AromaSphere.png");
-    textures["aroma sphere"] = aromaSphereTextures;
-
-    std::map<std::string, Texture2D> coolingShardTextures;
-    coolingShardTextures["default"] = BaseItem::LoadTexture("assets/CoolingShard.png");
-    textures["cooling shard"] = coolingShardTextures;
-
-    recipeTextures.push_back(BaseItem::LoadTexture("assets/RecipeBookCaramelEnergyCube.png"));
-    recipeTextures.push_back(BaseItem::LoadTexture("assets/RecipeBookSpicyFrostBomb.png"));
-    recipeTextures.push_back(BaseItem::LoadTexture("assets/RecipeBookProteinSalad.png"));
-    recipeTextures.push_back(BaseItem::LoadTexture("assets/RecipeBookLiquidFlameSoup.png"));
-    recipeTextures.push_back(BaseItem::LoadTexture("assets/RecipeBookFrostedEnergyTreat.png"));
-
-    std::string textureName;
-    std::unordered_map<std::string, std::map<std::string, Texture2D>> dishTextures = BaseItem::GetDishTextures();
-    for (auto textureSet : dishTextures) {
-        for (auto texturePair : textureSet.second) {
-            if (texturePair.first == "default") {
-                orderTextures[textureSet.first] = texturePair.second;
-            }
-        }
-    }
-
-    for (auto textureSet : textures) {
-        for (auto texturePair : textureSet.second) {
-            if (texturePair.first == "default") {
-                orderTextures[textureSet.first] = texturePair.second;
-            }
-        }
+    BaseItem::AddTexture("null", ItemState::Default, "assets/NULL.png");
+    BaseItem::AddTexture("chopping board", ItemState::Default, "assets/ChoppingBoard.png");
+    BaseItem::AddTexture("frying pan", ItemState::Default, "assets/FryingPan.png");
+    BaseItem::AddTexture("plate", ItemState::Default, "assets/Plate.png");
+
+    BaseItem::AddTexture("sweet crystal", ItemState::Default, "assets/SweetCrystal.png");
+    BaseItem::AddTexture("sweet crystal", ItemState::Cooked, "assets/CaramelEssence.png");
+    BaseItem::AddTexture("sweet crystal", ItemState::Chopped, "assets/SugarShards.png");
+
+    BaseItem::AddTexture("spice particle", ItemState::Default, "assets/SpiceParticle.png");
+    BaseItem::AddTexture("energy particle", ItemState::Default, "assets/EnergyParticle.png");
+    BaseItem::AddTexture("liquid essence", ItemState::Default, "assets/LiquidEssence.png");
+    BaseItem::AddTexture("protein orb", ItemState::Default, "assets/ProteinOrb.png");
+    BaseItem::AddTexture("vegetable core", ItemState::Default, "assets/VegetableCore.png");
+    BaseItem::AddTexture("aroma sphere", ItemState::Default, "assets/AromaSphere.png");
+    BaseItem::AddTexture("cooling shard", ItemState::Default, "assets/CoolingShard.png");
+
+    // Packs every texture into the atlas, so items, orders and the recipe book draw from a single page
+    BaseItem::PackTextures();
+
+    // Orders and the recipe book show the default texture of each type, and the processed
+    // dishes that only exist as another type's chopped or cooked texture
+    const std::vector<TextureSet>& textureSets = BaseItem::GetTextureSets();
+    std::vector<Sprite> orderSprites(textureSets.size());
+    for (size_t slot = 0; slot < textureSets.size(); slot++) {
+        orderSprites[slot] = textureSets[slot][static_cast<size_t>(ItemState::Default)];
     }
 
-    orderTextures["spicy frost bomb"] = dishTextures["frozen spice mix"]["chopped"];
-    orderTextures["liquid flame soup"] = dishTextures["spiced liquid"]["cooked"];
-    orderTextures["caramel essence"] = sweetCrystalTextures["cooked"];
-    orderTextures["sugar shards"] = sweetCrystalTextures["chopped"];
+    orderSprites[ContentNames::Find("spicy frost bomb")] = BaseItem::GetTextureSet("frozen spice mix")[static_cast<size_t>(ItemState::Chopped)];
+    orderSprites[ContentNames::Find("liquid flame soup")] = BaseItem::GetTextureSet("spiced liquid")[static_cast<size_t>(ItemState::Cooked)];
+    orderSprites[ContentNames::Find("caramel essence")] = BaseItem::GetTextureSet("sweet crystal")[static_cast<size_t>(ItemState::Cooked)];
+    orderSprites[ContentNames::Find("sugar shards")] = BaseItem::GetTextureSet("sweet crystal")[static_cast<size_t>(ItemState::Chopped)];
 
     // =============================================================================================
 
-    RecipeBook recipeBook(recipeTextures);
-    Order::SetupOrders(orderTextures);
-
-    // Adds individual items
-    std::vector<BaseItem*> items;
-    items.push_back(new Tool(choppingBoardTextures, "chopping board"));
-    items.push_back(new Tool(choppingBoardTextures, "chopping board"));
-    items.push_back(new Tool(fryingPanTextures, "frying pan", 120.f, 120.f));
-    items.push_back(new Tool(fryingPanTextures, "frying pan", 120.f, 120.f));
+    RecipeBook recipeBook(orderSprites);
+    FileWatcher recipeWatcher("assets/recipes.txt");  // Recipe edits are picked up without restarting the game
+    Order::SetupOrders(orderSprites);
 
     // Sets the types of the counters
     // Delivery = dishes are submitted here
@@ -474,25 +343,26 @@ int main() {
     // Source = infinite supply of the item specified
     Counter counter;
     counter.CreateCounter();
-    counter.GetUnits()[1].SetType("delivery");
-    counter.GetUnits()[2].SetType("delivery");
-    counter.GetUnits()[16].SetType("bin");
-    counter.GetUnits()[17].SetType("bin");
-    counter.GetUnits()[0].SetType("source", "plate");
-    counter.GetUnits()[3].SetType("source", "plate");
-    counter.GetUnits()[6].SetType("source", "sweet crystal");
-    counter.GetUnits()[7].SetType("source", "energy particle");
-    counter.GetUnits()[12].SetType("source", "spice particle");
-    counter.GetUnits()[13].SetType("source", "liquid essence");
-    counter.GetUnits()[20].SetType("source", "protein orb");
-    counter.GetUnits()[21].SetType("source", "vegetable core");
-    counter.GetUnits()[26].SetType("source", "aroma sphere");
-    counter.GetUnits()[27].SetType("source", "cooling shard");
-
-    counter.GetUnits()[4].AddItem(items[0]);
-    counter.GetUnits()[5].AddItem(items[1]);
-    counter.GetUnits()[8].AddItem(items[2]);
-    counter.GetUnits()[9].AddItem(items[3]);
+    counter.GetUnits()[1].SetType(CounterUnit::UnitType::Delivery);
+    counter.GetUnits()[2].SetType(CounterUnit::UnitType::Delivery);
+    counter.GetUnits()[16].SetType(CounterUnit::UnitType::Bin);
+    counter.GetUnits()[17].SetType(CounterUnit::UnitType::Bin);
+    counter.GetUnits()[0].SetType(CounterUnit::UnitType::Source, "plate");
+    counter.GetUnits()[3].SetType(CounterUnit::UnitType::Source, "plate");
+    counter.GetUnits()[6].SetType(CounterUnit::UnitType::Source, "sweet crystal");
+    counter.GetUnits()[7].SetType(CounterUnit::UnitType::Source, "energy particle");
+    counter.GetUnits()[12].SetType(CounterUnit::UnitType::Source, "spice particle");
+    counter.GetUnits()[13].SetType(CounterUnit::UnitType::Source, "liquid essence");
+    counter.GetUnits()[20].SetType(CounterUnit::UnitType::Source, "protein orb");
+    counter.GetUnits()[21].SetType(CounterUnit::UnitType::Source, "vegetable core");
+    counter.GetUnits()[26].SetType(CounterUnit::UnitType::Source, "aroma sphere");
+    counter.GetUnits()[27].SetType(CounterUnit::UnitType::Source, "cooling shard");
+
+    // Adds individual items, which stay in the list of live items until they are destroyed
+    counter.GetUnits()[4].AddItem(BaseItem::Create<Tool>("chopping board"));
+    counter.GetUnits()[5].AddItem(BaseItem::Create<Tool>("chopping board"));
+    counter.GetUnits()[8].AddItem(BaseItem::Create<Tool>("frying pan", 120.f, 120.f));
+    counter.GetUnits()[9].AddItem(BaseItem::Create<Tool>("frying pan", 120.f, 120.f));
 
     bool running = true;
 
@@ -519,6 +389,11 @@ int main() {
         std::string titleText = ss.str();
         SetWindowTitle(titleText.c_str());
         
+        // Applies edits to the recipe file, leaving the items in play as they are
+        if (recipeWatcher.HasChanged() && BaseItem::ReloadRecipes()) {
+            recipeBook.Refresh();
+        }
+
         // Logic if the game is on the menu
         if (gameState == "menu") {
             drawMenu(gameState, startButtons, highScore);
@@ -542,20 +417,18 @@ int main() {
             auto& units = counter.GetUnits();
             for (int i = 0; i < units.size(); i++) {
                 // If the unit is a source, and there is nothing currently placed
-                if (units[i].GetType() == "source" && units[i].GetPlaced() == nullptr) {
+                if (units[i].GetType() == CounterUnit::UnitType::Source && units[i].GetPlaced() == nullptr) {
                     if (units[i].GetSourceType() == "plate") {
-                        items.push_back(new Plate(textures[units[i].GetSourceType()]));  // Adds an item of type Plate
-                        units[i].AddItem(items[items.size() - 1]);  // Places the plate on the unit
+                        units[i].AddItem(BaseItem::Create<Plate>());  // Adds an item of type Plate and places it on the unit
                     }
                     else {
-                        items.push_back(new Ingredient(textures[units[i].GetSourceType()], units[i].GetSourceType()));  // Adds the item based on the type of the source
-                        units[i].AddItem(items[items.size() - 1]);  // Places the item on the unit
+                        units[i].AddItem(BaseItem::Create<Ingredient>(units[i].GetSourceType()));  // Adds the item based on the type of the source and places it on the unit
                     }
                 }
             }
 
             Tick(deltaTime, score, globalTime, gameTimer, timeSinceOrder, timeToNext, player,
-                    counter, items, orders, recipeBook, tutorialOrders, ordersDelivered, orderLevels);
+                    counter, orders, recipeBook, tutorialOrders, ordersDelivered, orderLevels);
 
             // If time runs out, ends and resets the game
             if (gameTimer <= 0.f) {
@@ -570,19 +443,18 @@ int main() {
 
                 for (auto& unit : counter.GetUnits()) {
                     unit.ClearPlaced();
+                    unit.ClearServing();
                 }
 
-                items.clear();
-
-                items.push_back(new Tool(choppingBoardTextures, "chopping board"));
-                items.push_back(new Tool(choppingBoardTextures, "chopping board"));
-                items.push_back(new Tool(fryingPanTextures, "frying pan", 120.f, 120.f));
-                items.push_back(new Tool(fryingPanTextures, "frying pan", 120.f, 120.f));
+                // Frees the whole round at once, destroying each item takes it out of the kitchen hash. Events left
+                // from the last frame refer to items and orders that are gone
+                BaseItem::DestroyAll();
+                GameEvents::Clear();
 
-                counter.GetUnits()[4].AddItem(items[0]);
-                counter.GetUnits()[5].AddItem(items[1]);
-                counter.GetUnits()[8].AddItem(items[2]);
-                counter.GetUnits()[9].AddItem(items[3]);
+                counter.GetUnits()[4].AddItem(BaseItem::Create<Tool>("chopping board"));
+                counter.GetUnits()[5].AddItem(BaseItem::Create<Tool>("chopping board"));
+                counter.GetUnits()[8].AddItem(BaseItem::Create<Tool>("frying pan", 120.f, 120.f));
+                counter.GetUnits()[9].AddItem(BaseItem::Create<Tool>("frying pan", 120.f, 120.f));
 
                 score = 0;
                 globalTime = 0.f;
@@ -603,8 +475,10 @@ int main() {
         }
     }
 
-    // Unloads textures and closes the window
+    // Frees the items, unloads textures and sounds and closes the window
+    BaseItem::DestroyAll();
     BaseItem::UnloadStaticTextures();
+    BaseItem::UnloadStaticSounds();
     CloseWindow();
 
     return 0;
@@ -0,0 +1,66 @@
+#include "mappedFile.h"
+
+// windows.h clashes with raylib.h, so it is only included in this file
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path)
+{
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return;
+    fileHandle = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) return;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) return;
+    mappingHandle = mapping;
+
+    fileData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (fileData != nullptr) fileSize = static_cast<size_t>(size.QuadPart);
+}
+
+MappedFile::~MappedFile()
+{
+    if (fileData != nullptr) UnmapViewOfFile(fileData);
+    if (mappingHandle != nullptr) CloseHandle(mappingHandle);
+    if (fileHandle != nullptr) CloseHandle(fileHandle);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path)
+{
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) return;
+
+    struct stat status;
+    if (fstat(file, &status) == 0 && status.st_size > 0) {
+        void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        if (data != MAP_FAILED) {
+            fileData = data;
+            fileSize = static_cast<size_t>(status.st_size);
+        }
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    close(file);
+}
+
+MappedFile::~MappedFile()
+{
+    if (fileData != nullptr) munmap(const_cast<void*>(fileData), fileSize);
+}
+
+#endif
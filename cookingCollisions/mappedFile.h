@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// A read-only view of a whole file mapped into memory, unmapped when destroyed
+class MappedFile
+{
+public:
+	MappedFile(const std::string& path);
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// Getters
+	bool IsOpen() const { return fileData != nullptr; }
+	const unsigned char* GetData() const { return static_cast<const unsigned char*>(fileData); }
+	size_t GetSize() const { return fileSize; }
+
+private:
+	const void* fileData = nullptr;
+	size_t fileSize = 0;
+
+	// Platform handles, kept as void* so that windows.h is never included next to raylib.h
+	void* fileHandle = nullptr;
+	void* mappingHandle = nullptr;
+};
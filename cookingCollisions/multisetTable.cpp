@@ -0,0 +1,103 @@
+#include "multisetTable.h"
+#include <algorithm>
+
+void MultisetTable::Clear()
+{
+	slots.clear();
+	ingredientPool.clear();
+	slotsUsed = 0;
+	maxRecipeSize = 0;
+}
+
+// Stores a recipe and every part of it with two or more ingredients. If two recipes share the same
+// ingredients the first one added is kept
+void MultisetTable::AddRecipe(const std::vector<ItemId>& ingredients, ItemId result)
+{
+	std::vector<ItemId> sorted = ingredients;
+	std::sort(sorted.begin(), sorted.end());
+	maxRecipeSize = std::max(maxRecipeSize, sorted.size());
+
+	Insert(sorted.data(), sorted.size(), result);
+	if (sorted.size() > maxPartIngredients) return;
+
+	// Each subset of positions picks a part, repeated IDs make some parts come up more than once but Insert keeps the first
+	std::vector<ItemId> part;
+	std::uint32_t fullMask = (1u << sorted.size()) - 1;
+	for (std::uint32_t mask = 1; mask < fullMask; mask++) {
+		part.clear();
+		for (size_t i = 0; i < sorted.size(); i++) {
+			if (mask & (1u << i)) part.push_back(sorted[i]);
+		}
+		if (part.size() >= 2) Insert(part.data(), part.size(), noItem);
+	}
+}
+
+// One probe in the common case, the table is kept at most half full
+MultisetTable::Match MultisetTable::Find(const ItemId* ids, size_t count) const
+{
+	if (slots.empty() || count < 2) return { false, noItem };
+
+	size_t mask = slots.size() - 1;
+	std::uint64_t hash = Hash(ids, count);
+	for (size_t index = static_cast<size_t>(hash) & mask;; index = (index + 1) & mask) {
+		const Slot& slot = slots[index];
+		if (slot.count == 0) return { false, noItem };
+		if (slot.hash == hash && slot.count == count && std::equal(ids, ids + count, ingredientPool.data() + slot.start)) {
+			return { true, slot.result };
+		}
+	}
+}
+
+// FNV-1a over the sorted IDs, finished with a multiply so the low bits used for indexing are well mixed
+std::uint64_t MultisetTable::Hash(const ItemId* ids, size_t count)
+{
+	std::uint64_t hash = 14695981039346656037ull;
+	for (size_t i = 0; i < count; i++) {
+		hash ^= ids[i];
+		hash *= 1099511628211ull;
+	}
+	return (hash ^ (hash >> 29)) * 0xBF58476D1CE4E5B9ull;
+}
+
+MultisetTable::Slot* MultisetTable::FindSlot(std::uint64_t hash, const ItemId* ids, size_t count)
+{
+	size_t mask = slots.size() - 1;
+	for (size_t index = static_cast<size_t>(hash) & mask;; index = (index + 1) & mask) {
+		Slot& slot = slots[index];
+		if (slot.count == 0) return &slot;
+		if (slot.hash == hash && slot.count == count && std::equal(ids, ids + count, ingredientPool.data() + slot.start)) return &slot;
+	}
+}
+
+// Adds a multiset, or gives an existing part its result if it completes a recipe
+void MultisetTable::Insert(const ItemId* ids, size_t count, ItemId result)
+{
+	if ((slotsUsed + 1) * 2 > slots.size()) GrowSlots();
+
+	std::uint64_t hash = Hash(ids, count);
+	Slot* slot = FindSlot(hash, ids, count);
+	if (slot->count != 0) {
+		if (slot->result == noItem) slot->result = result;
+		return;
+	}
+
+	*slot = { hash, static_cast<std::uint32_t>(ingredientPool.size()), static_cast<std::uint16_t>(count), result };
+	ingredientPool.insert(ingredientPool.end(), ids, ids + count);
+	slotsUsed++;
+}
+
+// Doubles the table, the stored hashes mean no multiset has to be hashed again
+void MultisetTable::GrowSlots()
+{
+	std::vector<Slot> oldSlots;
+	oldSlots.swap(slots);
+	slots.assign(oldSlots.empty() ? 64 : oldSlots.size() * 2, { 0, 0, 0, noItem });
+
+	size_t mask = slots.size() - 1;
+	for (const auto& slot : oldSlots) {
+		if (slot.count == 0) continue;
+		size_t index = static_cast<size_t>(slot.hash) & mask;
+		while (slots[index].count != 0) index = (index + 1) & mask;
+		slots[index] = slot;
+	}
+}
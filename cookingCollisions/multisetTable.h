@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Maps a multiset of item IDs to the recipe it completes in a single probe of an open-addressed hash table.
+// A multiset is given as its IDs in ascending order. Every part of a recipe is stored as well, so a plate
+// holding some of the ingredients can be checked in the same way as a finished one
+class MultisetTable
+{
+public:
+	using ItemId = std::uint16_t;
+
+	static constexpr ItemId noItem = UINT16_MAX;
+	static constexpr size_t maxPartIngredients = 12;  // Recipes with more ingredients only match when complete
+
+	struct Match {
+		bool isPart;  // The items are all or part of some recipe
+		ItemId result;  // What the items make, noItem unless they complete a recipe
+	};
+
+	void Clear();
+	void AddRecipe(const std::vector<ItemId>& ingredients, ItemId result);
+
+	Match Find(const ItemId* ids, size_t count) const;
+
+	// Getters
+	size_t GetMaxRecipeSize() const { return maxRecipeSize; }
+	size_t GetMemoryUsage() const { return slots.capacity() * sizeof(Slot) + ingredientPool.capacity() * sizeof(ItemId); }
+
+private:
+	struct Slot {
+		std::uint64_t hash;
+		std::uint32_t start;  // Where the multiset's IDs start in the ingredient pool
+		std::uint16_t count;  // 0 for an empty slot
+		ItemId result;
+	};
+
+	static std::uint64_t Hash(const ItemId* ids, size_t count);
+	Slot* FindSlot(std::uint64_t hash, const ItemId* ids, size_t count);
+	void Insert(const ItemId* ids, size_t count, ItemId result);
+	void GrowSlots();
+
+	std::vector<Slot> slots;
+	std::vector<ItemId> ingredientPool;
+	size_t slotsUsed = 0;
+	size_t maxRecipeSize = 0;
+};
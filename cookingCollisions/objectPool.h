@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Makes objects of any of Types, which all derive from Base, in blocks big enough for the largest of them.
+// Making and destroying an object are O(1) through a free list of blocks, and blocks live in chunks that are
+// never moved or freed until the pool is, so a long session reuses the same memory instead of growing.
+// Destroying the pool frees its chunks without destroying the objects still in them, since their destructors may
+// use state that is already gone by then, such as other thread_locals. Call Reset first to have them run
+template<typename Base, typename... Types>
+class ObjectPool
+{
+public:
+	ObjectPool() = default;
+	~ObjectPool() = default;
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	template<typename T, typename... Args>
+	T* Create(Args&&... args)
+	{
+		static_assert((std::is_same_v<T, Types> || ...), "The pool only makes the types it was declared with");
+		static_assert(std::is_base_of_v<Base, T>, "Pooled types have to derive from the base type");
+
+		Block* block = TakeBlock();
+		T* object = new (block->storage) T(std::forward<Args>(args)...);
+		block->object = object;
+		liveCount++;
+		return object;
+	}
+
+	// Destroys an object made by Create and puts its block back on the free list
+	void Destroy(Base* object)
+	{
+		if (object == nullptr) return;
+
+		// The object starts at its block, which starts with its storage
+		Block* block = reinterpret_cast<Block*>(dynamic_cast<void*>(object));
+		object->~Base();
+		block->object = nullptr;
+		block->nextFree = freeList;
+		freeList = block;
+		liveCount--;
+	}
+
+	// Destroys every object still alive at once, keeping the chunks for whatever is made next
+	void Reset()
+	{
+		freeList = nullptr;
+		for (auto& chunk : chunks) {
+			for (size_t i = 0; i < chunkSize; i++) {
+				Block& block = chunk[i];
+				if (block.object != nullptr) {
+					block.object->~Base();
+					block.object = nullptr;
+				}
+				block.nextFree = freeList;
+				freeList = &block;
+			}
+		}
+		liveCount = 0;
+	}
+
+	// Getters
+	size_t GetLiveCount() const { return liveCount; }
+	size_t GetCapacity() const { return chunks.size() * chunkSize; }
+
+private:
+	static constexpr size_t blockSize = std::max({ sizeof(Types)... });
+	static constexpr size_t blockAlign = std::max({ alignof(Types)... });
+	static constexpr size_t chunkSize = 64;
+
+	struct Block {
+		alignas(blockAlign) unsigned char storage[blockSize];
+		Base* object = nullptr;  // Set while the block holds a live object
+		Block* nextFree = nullptr;
+	};
+
+	// Takes a free block, adding a chunk of them when there are none left
+	Block* TakeBlock()
+	{
+		if (freeList == nullptr) {
+			chunks.push_back(std::make_unique<Block[]>(chunkSize));
+			Block* chunk = chunks.back().get();
+			for (size_t i = chunkSize; i-- > 0;) {
+				chunk[i].nextFree = freeList;
+				freeList = &chunk[i];
+			}
+		}
+
+		Block* block = freeList;
+		freeList = block->nextFree;
+		return block;
+	}
+
+	std::vector<std::unique_ptr<Block[]>> chunks;
+	Block* freeList = nullptr;
+	size_t liveCount = 0;
+};
@@ -1,14 +1,18 @@
 #include "order.h"
+#include "contentNames.h"
+#include "items.h"
+#include "gameEvents.h"
 #include <math.h>
 
 // Defines static attributes
 std::vector<std::string> Order::availableTypes;
-std::unordered_map<std::string, Texture2D> Order::dishTextures;
+std::vector<Sprite> Order::dishSprites;
 
 // Constructor for the Order class
 Order::Order(float time)
 {
     dish = availableTypes[RandomNumber(0, static_cast<int>(availableTypes.size()) - 1)];  // Randomly determines which dish to order
+    ResolveDish();
     maxTime = time;
     timeRemaining = maxTime;
 }
@@ -16,13 +20,23 @@ Order::Order(float time)
 Order::Order(const std::string& dishName)
 {
     dish = dishName;
+    ResolveDish();
     maxTime = 600.f;
     timeRemaining = maxTime;
 }
 
-void Order::SetupOrders(const std::unordered_map<std::string, Texture2D>& textures)
+// Finds the dish's content slot and ID once. Needs the content names built by BaseItem::SetupClass, so a dish
+// missing from them is reported rather than silently drawn without its icon
+void Order::ResolveDish()
 {
-    dishTextures = textures;
+    dishSlot = ContentNames::Find(dish);
+    dishId = BaseItem::GetTypeId(dish);
+    if (dishSlot == ContentNames::npos) std::cerr << "Ordered dish " << dish << " has no content slot and will be drawn without an icon" << std::endl;
+}
+
+void Order::SetupOrders(const std::vector<Sprite>& sprites)
+{
+    dishSprites = sprites;
 }
 
 // Static method to generate a random integer in a range
@@ -43,8 +57,8 @@ int Order::RandomNumber(int min, int max)
 // Draws the name of the dish to the screen
 void Order::DrawDish()
 {   
-    // The selects the section of the texture to draw (the whole texture)
-    Rectangle source = { 0, 0, (float)GetTextures()[dish].width, (float)GetTextures()[dish].height };
+    // The sprite's page and the section of it the sprite is in
+    Sprite sprite = GetSprite();
 
     // The rect that determines the position and dimensions of the texture
     Rectangle dest = {
@@ -60,12 +74,14 @@ void Order::DrawDish()
         (GetSize().x) / 2.f
     };
 
-    DrawTexturePro(GetTextures()[dish], source, dest, origin, 0.f, WHITE);
+    DrawTexturePro(sprite.texture, sprite.source, dest, origin, 0.f, WHITE);
 }
 
 // Handles logic and drawing orders
 void Order::Tick(float deltaTime)
 {
+    // Only the frame the timer runs out on reports it, the order is removed when the events are next handled
+    if (timeRemaining > 0.f && timeRemaining - deltaTime <= 0.f) GameEvents::OrderExpired(this);
     timeRemaining -= deltaTime;
 
     screenPos.x = 250.f * static_cast<float>(winWidth) / 800.f + (size.x + 20.f) * orderNum;  // Determines the position based on its number
@@ -7,6 +7,8 @@
 #include "raylib.h"
 #include <unordered_map>
 #include "config.h"
+#include "recipeGraph.h"
+#include "textureAtlas.h"
 
 class Order
 {
@@ -16,7 +18,7 @@ public:
 	void Tick(float deltaTime);
 	void DrawDish();
 
-	static void SetupOrders(const std::unordered_map<std::string, Texture2D>& textures);
+	static void SetupOrders(const std::vector<Sprite>& sprites);
 	static int RandomNumber(int min, int max);
 	static void AddType(const std::vector<std::string>& types) { for (auto type : types)
 		availableTypes.push_back(type); };
@@ -25,8 +27,9 @@ public:
 
 	// Getters
 	float GetTime() { return timeRemaining; }
-	std::string GetDish() { return dish; }
-	std::unordered_map<std::string, Texture2D> GetTextures() { return dishTextures; }
+	const std::string& GetDish() const { return dish; }
+	RecipeGraph::ItemId GetDishId() const { return dishId; }
+	Sprite GetSprite() const { return dishSlot < dishSprites.size() ? dishSprites[dishSlot] : Sprite{}; }
 	Vector2 GetPos() { return screenPos; }
 	Vector2 GetSize() { return size; }
 
@@ -34,7 +37,11 @@ public:
 	void SetOrderNum(int num) { orderNum = num; }
 
 private:
+	void ResolveDish();
+
 	std::string dish;
+	RecipeGraph::ItemId dishId;  // Found once, so serving and planning compare IDs rather than names
+	size_t dishSlot;  // The dish's content slot, found once so drawing never hashes the name
 	int fontSize = 20;
 	float maxTime;
 	float timeRemaining;
@@ -44,5 +51,5 @@ private:
 	Vector2 size{80.f * static_cast<float>(winWidth) / 800.f, 90.f * static_cast<float>(winWidth) / 800.f};
 
 	static std::vector<std::string> availableTypes;
-	static std::unordered_map<std::string, Texture2D> dishTextures;
+	static std::vector<Sprite> dishSprites;  // Indexed by content slot
 };
\ No newline at end of file
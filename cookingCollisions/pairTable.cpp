@@ -0,0 +1,162 @@
+#include "pairTable.h"
+
+// Copies share attached storage, but owned storage is copied and the data pointers moved onto the copy
+PairTable& PairTable::operator=(const PairTable& other)
+{
+	if (this == &other) return *this;
+
+	hashed = other.hashed;
+	borrowed = other.borrowed;
+	dimension = other.dimension;
+	dense = other.dense;
+	slots = other.slots;
+	slotBits = other.slotBits;
+	slotsUsed = other.slotsUsed;
+
+	if (borrowed) {
+		denseData = other.denseData;
+		slotData = other.slotData;
+	}
+	else RefreshPointers();
+	return *this;
+}
+
+// Makes room for IDs below nodeCount, switching to the hash table once the dense array would get too large
+void PairTable::Reserve(size_t nodeCount)
+{
+	if (hashed || nodeCount <= dimension) return;
+	MakeOwned();
+
+	// Moves every existing entry from the dense array into the hash table
+	if (nodeCount > denseLimit) {
+		std::vector<ItemId> oldDense;
+		oldDense.swap(dense);
+		hashed = true;
+		GrowSlots();
+
+		for (size_t first = 0; first < dimension; first++) {
+			for (size_t second = 0; second < dimension; second++) {
+				ItemId result = oldDense[first * dimension + second];
+				if (result != noItem) InsertSlot(MakeKey(static_cast<ItemId>(first), static_cast<ItemId>(second)), result);
+			}
+		}
+		dimension = 0;
+		RefreshPointers();
+		return;
+	}
+
+	// Grows geometrically so that interning nodes one at a time stays cheap
+	size_t newDimension = dimension * 2 > nodeCount ? dimension * 2 : nodeCount;
+	if (newDimension > denseLimit) newDimension = denseLimit;
+
+	std::vector<ItemId> newDense(newDimension * newDimension, noItem);
+	for (size_t first = 0; first < dimension; first++) {
+		for (size_t second = 0; second < dimension; second++) {
+			newDense[first * newDimension + second] = dense[first * dimension + second];
+		}
+	}
+	dense.swap(newDense);
+	dimension = newDimension;
+	RefreshPointers();
+}
+
+void PairTable::Set(ItemId first, ItemId second, ItemId result)
+{
+	MakeOwned();
+	if (!hashed) {
+		Reserve(static_cast<size_t>(first > second ? first : second) + 1);
+	}
+
+	// Reserve may have just switched storage
+	if (!hashed) dense[static_cast<size_t>(first) * dimension + second] = result;
+	else InsertSlot(MakeKey(first, second), result);
+}
+
+void PairTable::Clear()
+{
+	MakeOwned();
+	for (auto& result : dense) {
+		result = noItem;
+	}
+	for (auto& slot : slots) {
+		slot = { emptyKey, noItem, 0 };
+	}
+	slotsUsed = 0;
+}
+
+void PairTable::Attach(const Layout& layout, const void* data)
+{
+	dense.clear();
+	slots.clear();
+
+	hashed = layout.hashed;
+	dimension = layout.dimension;
+	slotBits = layout.slotBits;
+	denseData = hashed ? nullptr : static_cast<const ItemId*>(data);
+	slotData = hashed ? static_cast<const Slot*>(data) : nullptr;
+	borrowed = true;
+}
+
+// Copies attached storage into the table's own vectors before it is changed
+void PairTable::MakeOwned()
+{
+	if (!borrowed) return;
+
+	if (hashed) {
+		slots.assign(slotData, slotData + (static_cast<size_t>(1) << slotBits));
+		slotsUsed = 0;
+		for (const auto& slot : slots) {
+			if (slot.key != emptyKey) slotsUsed++;
+		}
+	}
+	else dense.assign(denseData, denseData + dimension * dimension);
+
+	borrowed = false;
+	RefreshPointers();
+}
+
+// Linear probing, the table is kept at most half full so this is almost always one probe
+PairTable::ItemId PairTable::FindSlot(ItemId first, ItemId second) const
+{
+	std::uint32_t key = MakeKey(first, second);
+	size_t mask = (static_cast<size_t>(1) << slotBits) - 1;
+
+	for (size_t index = HashKey(key);; index = (index + 1) & mask) {
+		if (slotData[index].key == key) return slotData[index].result;
+		if (slotData[index].key == emptyKey) return noItem;
+	}
+}
+
+void PairTable::InsertSlot(std::uint32_t key, ItemId result)
+{
+	if ((slotsUsed + 1) * 2 > slots.size()) GrowSlots();
+
+	size_t mask = slots.size() - 1;
+	for (size_t index = HashKey(key);; index = (index + 1) & mask) {
+		if (slots[index].key == key) {
+			slots[index].result = result;
+			return;
+		}
+		if (slots[index].key == emptyKey) {
+			slots[index] = { key, result, 0 };
+			slotsUsed++;
+			return;
+		}
+	}
+}
+
+// Doubles the hash table and reinserts every entry
+void PairTable::GrowSlots()
+{
+	std::vector<Slot> oldSlots;
+	oldSlots.swap(slots);
+
+	slotBits = oldSlots.empty() ? 6 : slotBits + 1;
+	slots.assign(static_cast<size_t>(1) << slotBits, { emptyKey, noItem, 0 });
+	slotsUsed = 0;
+
+	for (const auto& slot : oldSlots) {
+		if (slot.key != emptyKey) InsertSlot(slot.key, slot.result);
+	}
+	RefreshPointers();
+}
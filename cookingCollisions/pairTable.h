@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Maps an ordered pair of item IDs to a result ID in a single lookup.
+// Small graphs use a dense N x N array, larger ones an open-addressed hash table
+class PairTable
+{
+public:
+	using ItemId = std::uint16_t;
+
+	static constexpr ItemId noItem = UINT16_MAX;  // Returned for pairs with no entry
+	static constexpr size_t denseLimit = 1024;  // Largest node count stored densely (2 MB)
+
+	struct Slot {
+		std::uint32_t key;
+		ItemId result;
+		std::uint16_t padding;
+	};
+
+	// Describes how the table's storage is laid out, so it can be written to a file and attached again
+	struct Layout {
+		bool hashed;
+		size_t dimension;  // Side length of the dense array
+		size_t slotBits;  // The hash table has 2^slotBits slots
+	};
+
+	PairTable() = default;
+	PairTable(const PairTable& other) { *this = other; }
+	PairTable& operator=(const PairTable& other);
+	PairTable(PairTable&&) = default;
+	PairTable& operator=(PairTable&&) = default;
+
+	void Reserve(size_t nodeCount);
+	void Set(ItemId first, ItemId second, ItemId result);
+	void Clear();
+
+	// Uses storage owned by someone else, such as a memory-mapped file, until the first change
+	void Attach(const Layout& layout, const void* data);
+
+	ItemId Get(ItemId first, ItemId second) const
+	{
+		if (!hashed) {
+			if (first >= dimension || second >= dimension) return noItem;
+			return denseData[static_cast<size_t>(first) * dimension + second];
+		}
+		return FindSlot(first, second);
+	}
+
+	// Getters
+	bool IsHashed() const { return hashed; }
+	Layout GetLayout() const { return { hashed, dimension, slotBits }; }
+	const void* GetData() const { return hashed ? static_cast<const void*>(slotData) : static_cast<const void*>(denseData); }
+	size_t GetDataSize() const { return hashed ? (static_cast<size_t>(1) << slotBits) * sizeof(Slot) : dimension * dimension * sizeof(ItemId); }
+	size_t GetMemoryUsage() const { return borrowed ? GetDataSize() : dense.capacity() * sizeof(ItemId) + slots.capacity() * sizeof(Slot); }
+
+private:
+	static constexpr std::uint32_t emptyKey = UINT32_MAX;
+
+	static std::uint32_t MakeKey(ItemId first, ItemId second) { return (static_cast<std::uint32_t>(first) << 16) | second; }
+	size_t HashKey(std::uint32_t key) const { return (key * 0x9E3779B1u) >> (32 - slotBits); }
+	ItemId FindSlot(ItemId first, ItemId second) const;
+	void InsertSlot(std::uint32_t key, ItemId result);
+	void GrowSlots();
+	void MakeOwned();
+	void RefreshPointers() { denseData = dense.data(); slotData = slots.data(); }
+
+	bool hashed = false;
+	bool borrowed = false;  // Set while the data pointers refer to attached storage
+
+	size_t dimension = 0;
+	std::vector<ItemId> dense;
+	const ItemId* denseData = nullptr;
+
+	std::vector<Slot> slots;
+	const Slot* slotData = nullptr;
+	size_t slotBits = 0;
+	size_t slotsUsed = 0;
+};
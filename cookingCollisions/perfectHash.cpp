@@ -0,0 +1,40 @@
+#include "perfectHash.h"
+#include <utility>
+
+// Builds the table over a set of names, whose order gives each name its index.
+// Returns false and leaves the table empty if a name is listed twice
+bool PerfectHash::Build(std::vector<std::string> names)
+{
+	size_t bucketCount = PerfectHashing::GetBucketCount(names.size());
+
+	std::vector<std::uint64_t> hashes(names.size());
+	for (size_t i = 0; i < names.size(); i++) hashes[i] = PerfectHashing::HashName(names[i]);
+
+	std::vector<size_t> order(names.size());
+	std::vector<size_t> bucketStarts(bucketCount + 1);
+	seeds.assign(bucketCount, 0);
+	slotNames.assign(names.size(), npos);
+	if (!PerfectHashing::PlaceNames(hashes, names.size(), seeds, slotNames, order, bucketStarts)) {
+		this->names.clear();
+		seeds.clear();
+		slotNames.clear();
+		return false;
+	}
+
+	this->names = std::move(names);
+	return true;
+}
+
+size_t PerfectHash::Find(std::string_view name) const
+{
+	if (names.empty()) return npos;
+	std::uint64_t hash = PerfectHashing::HashName(name);
+	size_t index = slotNames[PerfectHashing::GetSlot(hash, seeds[PerfectHashing::GetBucket(hash, seeds.size())], names.size())];
+	return index != npos && names[index] == name ? index : npos;
+}
+
+// Bytes used by the table, not counting the name strings
+size_t PerfectHash::GetMemoryUsage() const
+{
+	return names.capacity() * sizeof(std::string) + seeds.capacity() * sizeof(std::uint32_t) + slotNames.capacity() * sizeof(size_t);
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Minimal perfect hashes over fixed sets of names, which turn a name into its index in the set without collisions
+// so anything kept per name can live in a flat array. Both tables use hash and displace: names are split into
+// buckets by their hash, then each bucket, largest first, is given the first seed that sends all of its names to
+// free slots. A lookup is one hash of the name, one mix with its bucket's seed and one compare to reject unknown names
+namespace PerfectHashing
+{
+	constexpr size_t npos = SIZE_MAX;
+	constexpr std::uint32_t maxSeed = 1u << 24;  // Gives up on a bucket rather than searching forever
+
+	// FNV-1a over the name, computed once per name however many seeds are tried
+	constexpr std::uint64_t HashName(std::string_view name)
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+		for (char c : name) {
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	// Two names to a bucket on average keeps the seed table small while leaving most buckets easy to place
+	constexpr size_t GetBucketCount(size_t nameCount) { return nameCount / 2 + 1; }
+
+	constexpr size_t GetBucket(std::uint64_t hash, size_t bucketCount) { return static_cast<size_t>(hash >> 32) % bucketCount; }
+
+	// Mixes a bucket's seed into a name's hash to pick the name's slot
+	constexpr size_t GetSlot(std::uint64_t hash, std::uint32_t seed, size_t slotCount)
+	{
+		std::uint64_t mixed = hash ^ (seed * 0x9E3779B97F4A7C15ull);
+		mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+		mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+		return static_cast<size_t>((mixed ^ (mixed >> 31)) % slotCount);
+	}
+
+	// Finds a seed for every bucket and fills slotNames with the index of the name in each slot. Shared by both
+	// tables, which pass std::array at compile time and std::vector at load time. order and bucketStarts are
+	// scratch, bucketStarts holding one more entry than there are buckets. Returns false if a name is listed twice
+	template <typename Hashes, typename Seeds, typename Indices, typename Starts>
+	constexpr bool PlaceNames(const Hashes& hashes, size_t nameCount, Seeds& seeds, Indices& slotNames, Indices& order, Starts& bucketStarts)
+	{
+		size_t bucketCount = GetBucketCount(nameCount);
+
+		// Groups the names by bucket with a counting sort, using the seeds as each bucket's fill position
+		for (size_t bucket = 0; bucket <= bucketCount; bucket++) bucketStarts[bucket] = 0;
+		for (size_t name = 0; name < nameCount; name++) bucketStarts[GetBucket(hashes[name], bucketCount) + 1]++;
+		size_t largestBucket = 0;
+		for (size_t bucket = 0; bucket < bucketCount; bucket++) {
+			if (bucketStarts[bucket + 1] > largestBucket) largestBucket = bucketStarts[bucket + 1];
+			bucketStarts[bucket + 1] += bucketStarts[bucket];
+			seeds[bucket] = 0;
+		}
+		for (size_t name = 0; name < nameCount; name++) {
+			size_t bucket = GetBucket(hashes[name], bucketCount);
+			order[bucketStarts[bucket] + seeds[bucket]++] = name;
+		}
+		for (size_t slot = 0; slot < nameCount; slot++) slotNames[slot] = npos;
+
+		// Large buckets are the hardest to place, so they go while most slots are still free
+		for (size_t size = largestBucket; size > 0; size--) {
+			for (size_t bucket = 0; bucket < bucketCount; bucket++) {
+				size_t start = bucketStarts[bucket];
+				size_t end = bucketStarts[bucket + 1];
+				if (end - start != size) continue;
+
+				// Names with the same hash can never be split up by a seed
+				for (size_t i = start; i < end; i++) {
+					for (size_t j = i + 1; j < end; j++) {
+						if (hashes[order[i]] == hashes[order[j]]) return false;
+					}
+				}
+
+				std::uint32_t seed = 0;
+				for (;; seed++) {
+					if (seed == maxSeed) return false;
+
+					size_t placed = start;
+					while (placed < end) {
+						size_t slot = GetSlot(hashes[order[placed]], seed, nameCount);
+						if (slotNames[slot] != npos) break;
+						slotNames[slot] = order[placed];
+						placed++;
+					}
+					if (placed == end) break;
+
+					// Frees the slots this seed took before it collided
+					for (size_t i = start; i < placed; i++) slotNames[GetSlot(hashes[order[i]], seed, nameCount)] = npos;
+				}
+				seeds[bucket] = seed;
+			}
+		}
+		return true;
+	}
+
+	// Joins two lists of names, so one table can cover both
+	template <size_t Count1, size_t Count2>
+	constexpr std::array<std::string_view, Count1 + Count2> JoinNames(const std::array<std::string_view, Count1>& names1,
+		const std::array<std::string_view, Count2>& names2)
+	{
+		std::array<std::string_view, Count1 + Count2> names{};
+		for (size_t i = 0; i < Count1; i++) names[i] = names1[i];
+		for (size_t i = 0; i < Count2; i++) names[Count1 + i] = names2[i];
+		return names;
+	}
+}
+
+// A perfect hash built at compile time over names known when the game is compiled.
+// Find gives the index of a name in the array the table was built from, or npos
+template <size_t Count>
+class StaticPerfectHash
+{
+public:
+	static constexpr size_t npos = PerfectHashing::npos;
+
+	constexpr StaticPerfectHash(const std::array<std::string_view, Count>& names) : names(names)
+	{
+		std::array<std::uint64_t, Count> hashes{};
+		for (size_t i = 0; i < Count; i++) hashes[i] = PerfectHashing::HashName(names[i]);
+
+		std::array<size_t, Count> order{};
+		std::array<size_t, bucketCount + 1> bucketStarts{};
+		built = PerfectHashing::PlaceNames(hashes, Count, seeds, slotNames, order, bucketStarts);
+	}
+
+	constexpr size_t Find(std::string_view name) const
+	{
+		if (Count == 0) return npos;
+		std::uint64_t hash = PerfectHashing::HashName(name);
+		size_t index = slotNames[PerfectHashing::GetSlot(hash, seeds[PerfectHashing::GetBucket(hash, bucketCount)], Count)];
+		return index != npos && names[index] == name ? index : npos;
+	}
+
+	constexpr std::string_view GetName(size_t index) const { return names[index]; }
+	constexpr size_t GetSize() const { return Count; }
+	constexpr bool IsBuilt() const { return built; }  // False if a name was listed twice
+
+private:
+	static constexpr size_t bucketCount = PerfectHashing::GetBucketCount(Count);
+
+	std::array<std::string_view, Count> names{};
+	std::array<std::uint32_t, bucketCount> seeds{};
+	std::array<size_t, Count> slotNames{};
+	bool built = false;
+};
+
+// The same perfect hash built at load time, for names that come from data files
+class PerfectHash
+{
+public:
+	static constexpr size_t npos = PerfectHashing::npos;
+
+	bool Build(std::vector<std::string> names);
+	size_t Find(std::string_view name) const;
+
+	// Getters
+	const std::string& GetName(size_t index) const { return names[index]; }
+	size_t GetSize() const { return names.size(); }
+	size_t GetMemoryUsage() const;
+
+private:
+	std::vector<std::string> names;
+	std::vector<std::uint32_t> seeds;
+	std::vector<size_t> slotNames;
+};
@@ -63,122 +63,106 @@ void Player::HandleItems(const std::vector<CounterUnit*>& units)
         for (auto* unit : units) {
             if (!unit->GetSelected()) continue;
             auto* itemPlaced = unit->GetPlaced();
+            BaseItem* held = GetHolding();
 
             // Special interactions when holding shift
             if ((IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT))
-                && unit->GetType() != "bin" && unit->GetType() != "delivery" &&
-                itemHeld != nullptr && itemHeld->GetType() == "plate") {
+                && unit->GetType() != CounterUnit::UnitType::Bin && unit->GetType() != CounterUnit::UnitType::Delivery &&
+                held != nullptr && held->IsPlate()) {
                 // If looking at a plate, with nothing in your hands
-                if (itemHeld == nullptr && itemPlaced->GetPlaced() != nullptr) {
-                    SetHolding(itemPlaced->GetPlaced());
-                    itemPlaced->ClearItems();
+                if (held == nullptr && itemPlaced->GetPlaced() != nullptr) {
+                    SetHolding(itemPlaced->TakePlaced());
                 }
 
-                else if (itemHeld != nullptr && itemHeld->GetPlaced() != nullptr) {
+                else if (held != nullptr && held->GetPlaced() != nullptr) {
                     if (itemPlaced == nullptr) {
-                        unit->AddItem(itemHeld->GetPlaced());
-                        itemHeld->ClearItems();
+                        unit->AddItem(held->TakePlaced());
                     }
                 }
             }
 
             // If the player is not currently holding an item
-            else if (itemHeld == nullptr) {
+            else if (held == nullptr) {
                 // If there is nothing placed
                 if (itemPlaced == nullptr) continue;
 
                 // If the item placed can be picked up
+                // Ingredients waiting for the rest of a recipe come off one at a time
                 else if (itemPlaced->CanPickup()) {
-                    SetHolding(itemPlaced);
-                    unit->ClearPlaced();
+                    SetHolding(unit->TakePlaced());
                 }
                 // If there is nothing placed on the item that cannot itself be picked up
                 else if (itemPlaced->GetPlaced() == nullptr) continue;
 
                 // Otherwise pick up the item
                 else {
-                    SetHolding(itemPlaced->GetPlaced());
-                    itemPlaced->ClearItems();
+                    SetHolding(itemPlaced->TakePlaced());
                 }
             }
 
             // If the currently selected unit is a bin
-            else if (itemHeld != nullptr && unit->GetType() == "bin") {
-                if (itemHeld->GetType() == "plate" && itemHeld->GetPlaced() != nullptr) itemHeld->RemoveItems(false);
+            else if (held != nullptr && unit->GetType() == CounterUnit::UnitType::Bin) {
+                if (held->IsPlate() && held->GetPlaced() != nullptr) held->RemoveItems(false);
                 else {
-                    itemHeld->RemoveItems();
-                    itemHeld = nullptr;
+                    held->RemoveItems();
+                    SetHolding(nullptr);
                 }
             }
 
             // If the currently selected unit is a delivery unit
-            else if (itemHeld != nullptr && unit->GetType() == "delivery") {
-                if (itemHeld->GetPlaced() != nullptr) {
-                    unit->AddServing(itemHeld);
-                    itemHeld->SetPos(unit->GetCentre());
-                    itemHeld->SetServing(true);
+            else if (held != nullptr && unit->GetType() == CounterUnit::UnitType::Delivery) {
+                if (held->GetPlaced() != nullptr) {
+                    unit->AddServing(held);
+                    held->SetPos(unit->GetCentre());
+                    GameEvents::DishServed(held->GetHandle(), held->GetPlaced()->GetType());
                     SetHolding(nullptr);
                 }
             }
 
             // If there is nothing currently placed
-            else if (unit->CanPlace(itemHeld->GetType())) {
-                unit->AddItem(itemHeld);
+            else if (unit->CanPlace(held->GetType())) {
+                unit->AddItem(held);
                 SetHolding(nullptr);
             }
 
             // If the item is compatible with what is already placed
-            else if (itemPlaced->CanPlace(itemHeld->GetType())) {
-                itemPlaced->AddItem(itemHeld);
+            else if (itemPlaced->CanPlace(held->GetType())) {
+                itemPlaced->AddItem(held);
                 SetHolding(nullptr);
-
-                if (itemPlaced->GetType() == "frying pan") {
-                    itemPlaced->ResetTimer();
-                    BaseItem::PlaySoundEffect("frying");
-                }
             }
 
             // If holding a plate with something on it
-            else if (itemHeld->GetType() == "plate" && itemPlaced != nullptr) {
-                // If the item is a chopping board or frying pan
-                if ((itemPlaced->GetType() == "frying pan" || itemPlaced->GetType() == "chopping board")) {
+            else if (held->IsPlate() && itemPlaced != nullptr) {
+                // If the item is a station, such as a chopping board or frying pan
+                if (itemPlaced->IsStation()) {
                     // If there is something placed
                     if (itemPlaced->GetPlaced() != nullptr) {
-                        if (itemHeld->CanPlace(itemPlaced->GetPlaced()->GetType())) {
-                            itemHeld->AddItem(itemPlaced->GetPlaced());
-                            itemPlaced->ClearItems();
+                        if (held->CanPlace(itemPlaced->GetLastPlaced()->GetType())) {
+                            held->AddItem(itemPlaced->TakePlaced());
                         }
                     }
 
                     // If there is nothing placed
-                    else if (itemHeld->GetPlaced() != nullptr && itemPlaced->CanPlace(itemHeld->GetPlaced()->GetType())) {
-                        itemPlaced->AddItem(itemHeld->GetPlaced());
-                        itemHeld->ClearItems();
-
-                        if (itemPlaced->GetType() == "frying pan") {
-                            itemPlaced->ResetTimer();
-                            BaseItem::PlaySoundEffect("frying");
-                        }
+                    else if (held->GetPlaced() != nullptr && itemPlaced->CanPlace(held->GetLastPlaced()->GetType())) {
+                        itemPlaced->AddItem(held->TakePlaced());
                     }
                 }
 
                 // If the item placed can be placed on the plate
-                else if (itemHeld->CanPlace(itemPlaced->GetType())) {
-                    itemHeld->AddItem(itemPlaced);
-                    unit->ClearPlaced();
+                else if (held->CanPlace(unit->GetLastPlaced()->GetType())) {
+                    held->AddItem(unit->TakePlaced());
                 }
 
                 // If both the item held and the item placed is a plate
-                else if (itemPlaced->GetType() == "plate") {
+                else if (itemPlaced->IsPlate()) {
                     // If there is an item on both plates, add the held one to the placed one if possible
-                    if (itemHeld->GetPlaced() != nullptr && itemPlaced->GetPlaced() != nullptr &&
-                        itemPlaced->CanPlace(itemHeld->GetPlaced()->GetType())) {
-                        itemPlaced->AddItem(itemHeld->GetPlaced());
-                        itemHeld->ClearItems();
+                    if (held->GetPlaced() != nullptr && itemPlaced->GetPlaced() != nullptr &&
+                        itemPlaced->CanPlace(held->GetLastPlaced()->GetType())) {
+                        itemPlaced->AddItem(held->TakePlaced());
                     }
                     // Otherwise swap the plates
                     else {
-                        auto* tempPlate = itemHeld;
+                        auto* tempPlate = held;
                         SetHolding(itemPlaced);
                         unit->ClearPlaced();
                         unit->AddItem(tempPlate);
@@ -193,12 +177,20 @@ void Player::HandleItems(const std::vector<CounterUnit*>& units)
             auto* itemPlaced = unit->GetPlaced();
             if (itemPlaced == nullptr) continue;
             if (itemPlaced->GetPlaced() == nullptr) continue;
-            if (itemHeld != nullptr) continue;
+            if (GetHolding() != nullptr) continue;
             itemPlaced->HandleCooking();
         }
     }
 }
 
+// Holds an item, or nothing, moving what was held back to its own layer and the new item over everything else
+void Player::SetHolding(BaseItem* item)
+{
+    if (BaseItem* held = GetHolding()) held->SetHeld(false);
+    itemHeld = item != nullptr ? item->GetHandle() : ItemHandle{};
+    if (item != nullptr) item->SetHeld(true);
+}
+
 // Works out where carried items should be drawn
 void Player::CarryItem()
 {
@@ -210,9 +202,12 @@ void Player::CarryItem()
     offset.y = cos(itemAngle) * holdingDistance;
 
     // Updates the position and rotation of the object to match the player
-    itemHeld->SetPos(Vector2{ screenPos.x + offset.x, screenPos.y + offset.y });
-    itemHeld->SetRot(-viewDir + 180.f);
-    if (itemHeld->GetPlaced() != nullptr) itemHeld->GetPlaced()->SetRot(-viewDir + 180.f);
+    BaseItem* held = GetHolding();
+    held->SetPos(Vector2{ screenPos.x + offset.x, screenPos.y + offset.y });
+    held->SetRot(-viewDir + 180.f);
+    for (ItemHandle slot : held->GetItems()) {
+        if (BaseItem* item = BaseItem::Get(slot)) item->SetRot(-viewDir + 180.f);
+    }
 }
 
 // Checks if and if so how, the player is colliding with a unit
@@ -345,7 +340,7 @@ void Player::Tick(float deltaTime)
         viewDir = ClampPlate(viewDir, rotation, targetDir);
 
     }
-    if (itemHeld != nullptr) CarryItem();
+    if (GetHolding() != nullptr) CarryItem();
 }
 
 void Player::Draw()
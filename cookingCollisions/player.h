@@ -33,10 +33,11 @@ public:
 
     // Getters
     Vector2 GetPos() { return screenPos; }
+    BaseItem* GetHolding() const { return BaseItem::Get(itemHeld); }
 
     // Setters
     void SetPos(const Vector2& pos) { screenPos = pos; }
-    void SetHolding(BaseItem* item) { itemHeld = item; }
+    void SetHolding(BaseItem* item);
     void SetAngle(float angle) { viewDir = 0; }
 
 private:
@@ -49,7 +50,7 @@ private:
     float viewDir = 0.f;
     float rotateSpeed = 360.f * 3;
 
-    BaseItem* itemHeld = nullptr;
+    ItemHandle itemHeld;  // Goes stale if the item is destroyed, which empties the player's hands
     float holdingDistance = 30.f;
 
     float visionAngle = Radians(60.f);
@@ -1,10 +1,97 @@
 #include "recipeBook.h"
+#include "recipeGraph.h"
+#include "contentNames.h"
+#include <algorithm>
 
-RecipeBook::RecipeBook(const std::vector<Texture2D>& textures) :
-	recipeTextures(textures),
-    bookLength(static_cast<int>(textures.size()) - 1)
+RecipeBook::RecipeBook(const std::vector<Sprite>& itemSprites) :
+	sprites(itemSprites)
 {
+    BuildPages();
+    bookLength = static_cast<int>(pages.size()) - 1;
+}
+
+// Rebuilds the pages after the recipes change, staying on the same page where it still exists
+void RecipeBook::Refresh()
+{
+    pages.clear();
+    BuildPages();
+    bookLength = static_cast<int>(pages.size()) - 1;
+    bookPage = std::clamp(bookPage, 0, std::max(bookLength, 0));
+}
+
+// Builds a page for every dish, which is any item that is made from something but is not used to make anything else.
+// Each page is the dish's ingredient tree, with the raw ingredients on the left and the dish on the right
+void RecipeBook::BuildPages()
+{
+    const RecipeGraph& recipes = RecipeGraph::GetInstance();
+
+    // Simpler dishes come first, and the precomputed depths save walking every tree to sort them
+    std::vector<RecipeGraph::ItemId> dishes;
+    for (size_t id = 0; id < recipes.GetIdCount(); id++) {
+        RecipeGraph::ItemId dish = static_cast<RecipeGraph::ItemId>(id);
+        if (!recipes.GetProducers(dish).empty() && recipes.GetNeighbors(dish).empty()) dishes.push_back(dish);
+    }
+    std::stable_sort(dishes.begin(), dishes.end(), [&recipes](RecipeGraph::ItemId a, RecipeGraph::ItemId b) {
+        return recipes.GetRecipeDepth(a) < recipes.GetRecipeDepth(b);
+    });
+
+    for (RecipeGraph::ItemId dish : dishes) {
+        const auto& tree = recipes.GetIngredientTree(dish);
+        Page page;
+        page.dish = recipes.GetName(dish);
+
+        int maxDepth = 0;
+        std::vector<int> childCounts(tree.size(), 0);
+        for (const auto& node : tree) {
+            maxDepth = std::max(maxDepth, static_cast<int>(node.depth));
+            if (node.parent != -1) childCounts[node.parent]++;
+        }
+        int leafCount = static_cast<int>(std::count(childCounts.begin(), childCounts.end(), 0));
+
+        // The area below the title is split into a column per depth and a row per raw ingredient
+        const float left = 60.f;
+        const float top = 120.f;
+        float columnWidth = (winWidth - 2 * left) / (maxDepth + 1);
+        float rowHeight = (winHeight - top - 80.f) / leafCount;
+        page.iconSize = std::min(80.f, std::min(columnWidth, rowHeight) * 0.6f);
+
+        // The tree is in pre-order, so raw ingredients are met from top to bottom
+        int leaf = 0;
+        for (const auto& node : tree) {
+            PageEntry entry;
+            entry.name = recipes.GetName(node.item);
+            entry.input = node.input == RecipeGraph::noItem || recipes.GetName(node.input) == "none" ? "" : recipes.GetName(node.input);
+            entry.pos.x = left + columnWidth * (maxDepth - node.depth + 0.5f);
+            entry.pos.y = childCounts[page.entries.size()] == 0 ? top + rowHeight * (leaf++ + 0.5f) : 0.f;
+            entry.parent = node.parent;
+            page.entries.push_back(entry);
+        }
+
+        // Children always come after their parent, so walking backwards centres every item on its ingredients
+        for (size_t i = page.entries.size() - 1; i > 0; i--) {
+            PageEntry& entry = page.entries[i];
+            if (childCounts[i] != 0) entry.pos.y /= childCounts[i];
+            page.entries[entry.parent].pos.y += entry.pos.y;
+        }
+        if (childCounts[0] != 0) page.entries[0].pos.y /= childCounts[0];
+
+        pages.push_back(page);
+    }
+}
+
+// Draws an item's texture centred on a point, or its name if it has no texture
+void RecipeBook::DrawIcon(const std::string& name, Vector2 pos, float iconSize) const
+{
+    size_t slot = ContentNames::Find(name);
+    if (slot >= sprites.size() || !sprites[slot].IsLoaded()) {
+        DrawText(name.c_str(), static_cast<int>(pos.x - MeasureText(name.c_str(), 16) / 2), static_cast<int>(pos.y - 8.f), 16, BLACK);
+        return;
+    }
 
+    const Sprite& sprite = sprites[slot];
+    Rectangle dest = { pos.x, pos.y, iconSize, iconSize };
+    Vector2 origin = { iconSize / 2.f, iconSize / 2.f };
+    DrawTexturePro(sprite.texture, sprite.source, dest, origin, 0.f, WHITE);
 }
 
 // Handles logic and drawing
@@ -13,7 +100,7 @@ void RecipeBook::Tick()
 	if (IsKeyPressed(KEY_R)) isShowing = !isShowing;
 
     // Only performs logic if shown
-	if (isShowing) {
+	if (isShowing && !pages.empty()) {
         if (IsKeyPressed(KEY_LEFT)) {
             bookPage--;
             if (bookPage < 0) bookPage = bookLength;
@@ -23,22 +110,27 @@ void RecipeBook::Tick()
             if (bookPage > bookLength) bookPage = 0;
         }
 
-        // The selects the section of the texture to draw (the whole texture)
-        Rectangle source = { 0, 0, (float)recipeTextures[bookPage].width, (float)recipeTextures[bookPage].height };
-
-        // The rect that determines the position and dimensions of the texture
-        Rectangle dest = {
-            GetPos().x,
-            GetPos().y,
-            GetSize().x,
-            GetSize().y
-        };
-
-        // What point on the texture is treated as the origin (the centre)
-        Vector2 origin = {
-            (GetSize().x) / 2.f,
-            (GetSize().y) / 2.f
-        };
-        DrawTexturePro(recipeTextures[bookPage], source, dest, origin, 0.f, WHITE);
+        const Page& page = pages[bookPage];
+        DrawRectangle(0, 0, static_cast<int>(GetSize().x), static_cast<int>(GetSize().y), RAYWHITE);
+        DrawText(page.dish.c_str(), static_cast<int>(winWidth / 2.f - MeasureText(page.dish.c_str(), 40) / 2), 30, 40, BLACK);
+
+        // Draws the links first so the items sit on top of them, with the tool needed halfway along
+        for (const auto& entry : page.entries) {
+            if (entry.parent == -1) continue;
+            Vector2 parentPos = page.entries[entry.parent].pos;
+            DrawLineEx(entry.pos, parentPos, 3.f, DARKGRAY);
+            if (!entry.input.empty()) {
+                DrawIcon(entry.input, { (entry.pos.x + parentPos.x) / 2.f, (entry.pos.y + parentPos.y) / 2.f }, page.iconSize / 2.f);
+            }
+        }
+
+        for (const auto& entry : page.entries) {
+            DrawIcon(entry.name, entry.pos, page.iconSize);
+            DrawText(entry.name.c_str(), static_cast<int>(entry.pos.x - MeasureText(entry.name.c_str(), 14) / 2),
+                static_cast<int>(entry.pos.y + page.iconSize / 2.f + 4.f), 14, BLACK);
+        }
+
+        std::string pageText = std::to_string(bookPage + 1) + "/" + std::to_string(bookLength + 1) + "  Change page - LEFT/RIGHT";
+        DrawText(pageText.c_str(), static_cast<int>(winWidth / 2.f - MeasureText(pageText.c_str(), 20) / 2), winHeight - 40, 20, BLACK);
 	}
 }
\ No newline at end of file
@@ -1,21 +1,41 @@
 #pragma once
 
 #include "config.h"
+#include "textureAtlas.h"
 #include <vector>
 #include <string>
 
 class RecipeBook
 {
 public:
-	RecipeBook(const std::vector<Texture2D>& textures);
+	RecipeBook(const std::vector<Sprite>& itemSprites);
 	void Tick();
+	void Refresh();
 
 	// Getters
 	Vector2 GetPos() { return screenPos; }
 	Vector2 GetSize() { return size; }
 
 private:
-	std::vector<Texture2D> recipeTextures;
+	// An item on a page, placed from the dish's ingredient tree
+	struct PageEntry {
+		std::string name;
+		std::string input;  // Tool that turns this item into its parent, empty if it is combined or is the dish
+		Vector2 pos;
+		int parent;  // Index of the parent entry, -1 for the dish
+	};
+
+	struct Page {
+		std::string dish;
+		std::vector<PageEntry> entries;
+		float iconSize;
+	};
+
+	void BuildPages();
+	void DrawIcon(const std::string& name, Vector2 pos, float iconSize) const;
+
+	std::vector<Sprite> sprites;  // Indexed by content slot
+	std::vector<Page> pages;
 	int bookPage = 0;
 	int bookLength;
 	bool isShowing = false;
@@ -1,4 +1,8 @@
 #include "recipeGraph.h"
+#include <algorithm>
+#include <iterator>
+#include "frozenRecipeGraph.h"
+#include <stdexcept>
 
 RecipeGraph& RecipeGraph::GetInstance()
 {
@@ -6,6 +10,262 @@ RecipeGraph& RecipeGraph::GetInstance()
 	return instance;
 }
 
+// Returns the ID of a name, giving it the next free ID if it has not been seen before, and marks it as declared
+RecipeGraph::ItemId RecipeGraph::Intern(const std::string& name)
+{
+	ItemId id = InternName(name);
+	declared[id] = 1;
+	return id;
+}
+
+RecipeGraph::ItemId RecipeGraph::InternName(const std::string& name)
+{
+	auto it = ids.find(name);
+	if (it != ids.end()) return it->second;
+
+	// The largest ID is reserved for empty table entries
+	if (names.size() >= PairTable::noItem) throw std::length_error("RecipeGraph: too many interned names");
+
+	ItemId id = static_cast<ItemId>(names.size());
+	names.push_back(name);
+	declared.push_back(0);
+	ids.emplace(name, id);
+	idGraph.emplace_back();
+	producers.emplace_back();
+	requiredInputs.emplace_back();
+	reachabilityDirty = true;
+	topologyDirty = true;
+	revision++;
+	combinations.Reserve(names.size());
+	transitions.Reserve(names.size());
+	return id;
+}
+
+// Looks up the ID of a name without interning it
+std::optional<RecipeGraph::ItemId> RecipeGraph::GetId(const std::string& name) const
+{
+	auto it = ids.find(name);
+	if (it != ids.end()) return it->second;
+	return std::nullopt;
+}
+
+void RecipeGraph::AddNode(const std::string& node)
+{
+	graph[node] = {};
+
+	// Re-adding a node drops its edges, which can invalidate any combination entry
+	ItemId id = Intern(node);
+	if (idGraph[id].empty()) return;
+
+	for (const auto& edge : idGraph[id]) {
+		auto& edgeProducers = producers[edge.destination];
+		edgeProducers.erase(std::remove_if(edgeProducers.begin(), edgeProducers.end(),
+			[id](const Producer& producer) { return producer.source == id; }), edgeProducers.end());
+		RefreshRequiredInputs(edge.destination);
+	}
+	idGraph[id].clear();
+	ingredientTrees.clear();
+	reachabilityDirty = true;
+	recipesDirty = true;
+	topologyDirty = true;
+	revision++;
+	RebuildTables();
+}
+
+// Removes every node, edge and interned name
+void RecipeGraph::Clear()
+{
+	graph.clear();
+	names.clear();
+	declared.clear();
+	ids.clear();
+	idGraph.clear();
+	producers.clear();
+	requiredInputs.clear();
+	ingredientTrees.clear();
+	reachability.clear();
+	reachabilityDirty = true;
+	recipes.clear();
+	recipeTable.Clear();
+	recipesDirty = true;
+	topologicalOrder.clear();
+	recipeDepths.clear();
+	topologyDirty = true;
+	revision++;
+	combinations = PairTable();
+	transitions = PairTable();
+	tableStorage.reset();
+}
+
+void RecipeGraph::AddEdge(const std::string& from, const std::string& to, const std::string& input)
+{
+	graph[from].push_back({ to, input });
+
+	ItemId fromId = InternName(from);
+	ItemId toId = InternName(to);
+	ItemId inputId = InternName(input);
+	LinkEdge(fromId, toId, inputId);
+	UpdateCombinations(fromId, toId);
+
+	// The first edge with a given input wins, as it did when ApplyInputToNode walked the edges
+	if (transitions.Get(fromId, inputId) == PairTable::noItem) transitions.Set(fromId, inputId, toId);
+}
+
+// Adds an edge to the forward and reverse ID lists, leaving the tables to the caller
+void RecipeGraph::LinkEdge(ItemId from, ItemId to, ItemId input)
+{
+	idGraph[from].push_back({ to, input });
+	producers[to].push_back({ from, input });
+
+	auto& inputs = requiredInputs[to];
+	if (names[input] != "none" && std::find(inputs.begin(), inputs.end(), input) == inputs.end()) inputs.push_back(input);
+	ingredientTrees.clear();
+	reachabilityDirty = true;
+	recipesDirty = true;
+	topologyDirty = true;
+	revision++;
+}
+
+// Recollects the tool inputs needed to make a node after edges into it were removed
+void RecipeGraph::RefreshRequiredInputs(ItemId node)
+{
+	auto& inputs = requiredInputs[node];
+	inputs.clear();
+	for (const auto& producer : producers[node]) {
+		if (names[producer.input] != "none" && std::find(inputs.begin(), inputs.end(), producer.input) == inputs.end()) {
+			inputs.push_back(producer.input);
+		}
+	}
+}
+
+// Refreshes the table entries a new edge can change, which are the pairs of the new source with every other producer of the destination
+void RecipeGraph::UpdateCombinations(ItemId from, ItemId to)
+{
+	for (const auto& producer : producers[to]) {
+		SetCombination(from, producer.source, ScanCommonNode(from, producer.source));
+		SetCombination(producer.source, from, ScanCommonNode(producer.source, from));
+	}
+}
+
+// Stores what a pair combines into. Pairs with no result only overwrite an entry that is set, so in a hashed table
+// they never take a slot
+void RecipeGraph::SetCombination(ItemId first, ItemId second, std::optional<ItemId> result)
+{
+	if (result) combinations.Set(first, second, *result);
+	else if (combinations.Get(first, second) != PairTable::noItem) combinations.Set(first, second, PairTable::noItem);
+}
+
+// Recomputes the combination and transition tables from the edge lists
+void RecipeGraph::RebuildTables()
+{
+	transitions.Clear();
+	for (size_t from = 0; from < idGraph.size(); from++) {
+		for (const auto& edge : idGraph[from]) {
+			if (transitions.Get(static_cast<ItemId>(from), edge.input) == PairTable::noItem) {
+				transitions.Set(static_cast<ItemId>(from), edge.input, edge.destination);
+			}
+		}
+	}
+
+	combinations.Clear();
+	for (const auto& nodeProducers : producers) {
+		for (const auto& producer1 : nodeProducers) {
+			for (const auto& producer2 : nodeProducers) {
+				std::optional<ItemId> commonNode = ScanCommonNode(producer1.source, producer2.source);
+				if (commonNode) combinations.Set(producer1.source, producer2.source, *commonNode);
+			}
+		}
+	}
+}
+
+// Changes the graph to match another one, such as the same recipe file read again, and refreshes only the table entries of
+// nodes whose edges differ. Names are never forgotten, so every ID already handed out keeps its name and items of a type
+// the other graph dropped are still valid, they just no longer make anything. Returns how many nodes had their edges changed
+size_t RecipeGraph::ApplyChanges(const RecipeGraph& updated)
+{
+	// Names new to this graph take the next free IDs, and the other graph's IDs are translated through localIds.
+	// Names the other graph dropped stay interned but are no longer declared, so Validate reports them again
+	std::fill(declared.begin(), declared.end(), 0);
+	std::vector<ItemId> localIds(updated.names.size());
+	for (size_t id = 0; id < updated.names.size(); id++) {
+		localIds[id] = InternName(updated.names[id]);
+		declared[localIds[id]] = updated.declared[id];
+	}
+
+	auto sameEdge = [](const IdEdge& edge1, const IdEdge& edge2) {
+		return edge1.destination == edge2.destination && edge1.input == edge2.input;
+	};
+
+	// Finds the nodes whose edges changed. A combination entry can only be set for two nodes with a shared destination,
+	// so the entries to refresh pair each changed node with the other producers of its destinations before and after
+	std::vector<ItemId> changed;
+	std::vector<std::vector<IdEdge>> changedEdges;
+	std::vector<std::pair<ItemId, ItemId>> pairs;
+	std::vector<IdEdge> edges;
+	for (size_t node = 0; node < names.size(); node++) {
+		ItemId from = static_cast<ItemId>(node);
+		edges.clear();
+		std::optional<ItemId> updatedId = updated.GetId(names[from]);
+		if (updatedId) {
+			for (const auto& edge : updated.idGraph[*updatedId]) edges.push_back({ localIds[edge.destination], localIds[edge.input] });
+		}
+		if (std::equal(edges.begin(), edges.end(), idGraph[from].begin(), idGraph[from].end(), sameEdge)) continue;
+
+		changed.push_back(from);
+		changedEdges.push_back(edges);
+		for (const auto& edge : idGraph[from]) {
+			for (const auto& producer : producers[edge.destination]) pairs.emplace_back(from, producer.source);
+		}
+	}
+
+	// The string-keyed nodes follow the other graph
+	for (auto node = graph.begin(); node != graph.end();) {
+		node = updated.graph.count(node->first) ? std::next(node) : graph.erase(node);
+	}
+	for (const auto& node : updated.graph) graph.try_emplace(node.first);
+	if (changed.empty()) return 0;
+
+	for (size_t i = 0; i < changed.size(); i++) {
+		ItemId from = changed[i];
+		auto node = updated.graph.find(names[from]);
+		if (node != updated.graph.end()) graph[names[from]] = node->second;
+
+		// Unlinks the old edges, clearing the node's row of the transition table
+		for (const auto& edge : idGraph[from]) {
+			auto& edgeProducers = producers[edge.destination];
+			edgeProducers.erase(std::remove_if(edgeProducers.begin(), edgeProducers.end(),
+				[from](const Producer& producer) { return producer.source == from; }), edgeProducers.end());
+			RefreshRequiredInputs(edge.destination);
+			if (transitions.Get(from, edge.input) != PairTable::noItem) transitions.Set(from, edge.input, PairTable::noItem);
+		}
+		idGraph[from].clear();
+
+		for (const auto& edge : changedEdges[i]) {
+			LinkEdge(from, edge.destination, edge.input);
+			if (transitions.Get(from, edge.input) == PairTable::noItem) transitions.Set(from, edge.input, edge.destination);
+		}
+	}
+
+	for (ItemId from : changed) {
+		for (const auto& edge : idGraph[from]) {
+			for (const auto& producer : producers[edge.destination]) pairs.emplace_back(from, producer.source);
+		}
+	}
+	std::sort(pairs.begin(), pairs.end());
+	pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+	for (const auto& pair : pairs) {
+		SetCombination(pair.first, pair.second, ScanCommonNode(pair.first, pair.second));
+		SetCombination(pair.second, pair.first, ScanCommonNode(pair.second, pair.first));
+	}
+
+	ingredientTrees.clear();
+	reachabilityDirty = true;
+	recipesDirty = true;
+	topologyDirty = true;
+	revision++;
+	return changed.size();
+}
+
 const std::vector<RecipeGraph::Edge>& RecipeGraph::GetNeighbors(const std::string& node) const
 {
 	auto it = graph.find(node);
@@ -16,6 +276,407 @@ const std::vector<RecipeGraph::Edge>& RecipeGraph::GetNeighbors(const std::strin
 	}
 }
 
+const std::vector<RecipeGraph::IdEdge>& RecipeGraph::GetNeighbors(ItemId node) const
+{
+	if (node < idGraph.size()) return idGraph[node];
+	else {
+		static const std::vector<IdEdge> emptyVector;
+		return emptyVector;
+	}
+}
+
+// Every edge into a node
+const std::vector<RecipeGraph::Producer>& RecipeGraph::GetProducers(ItemId node) const
+{
+	if (node < producers.size()) return producers[node];
+	else {
+		static const std::vector<Producer> emptyVector;
+		return emptyVector;
+	}
+}
+
+// The tool inputs, other than none, used by any edge into a node
+const std::vector<RecipeGraph::ItemId>& RecipeGraph::GetRequiredInputs(ItemId node) const
+{
+	if (node < requiredInputs.size()) return requiredInputs[node];
+	else {
+		static const std::vector<ItemId> emptyVector;
+		return emptyVector;
+	}
+}
+
+// Expands everything a dish is made from down to the raw ingredients, the first request for each dish builds and caches the tree
+const std::vector<RecipeGraph::TreeNode>& RecipeGraph::GetIngredientTree(ItemId dish) const
+{
+	static const std::vector<TreeNode> emptyVector;
+	if (dish >= producers.size()) return emptyVector;
+
+	auto it = ingredientTrees.find(dish);
+	if (it != ingredientTrees.end()) return it->second;
+
+	std::vector<TreeNode> tree;
+
+	// Nodes are added to the tree as they are popped, so it comes out in pre-order, and children are pushed in reverse to keep the edge order
+	std::vector<TreeNode> stack = { { dish, noItem, 0, -1 } };
+	while (!stack.empty()) {
+		TreeNode node = stack.back();
+		stack.pop_back();
+		tree.push_back(node);
+		std::int32_t index = static_cast<std::int32_t>(tree.size() - 1);
+
+		const auto& nodeProducers = producers[node.item];
+		for (auto producer = nodeProducers.rbegin(); producer != nodeProducers.rend(); ++producer) {
+			// A producer that is already one of its own ancestors would expand forever
+			bool isCycle = false;
+			for (std::int32_t ancestor = index; ancestor != -1; ancestor = tree[ancestor].parent) {
+				if (tree[ancestor].item == producer->source) {
+					isCycle = true;
+					break;
+				}
+			}
+			if (isCycle) continue;
+
+			stack.push_back({ producer->source, producer->input, static_cast<std::uint16_t>(node.depth + 1), index });
+		}
+	}
+
+	return ingredientTrees.emplace(dish, std::move(tree)).first->second;
+}
+
+// Whether an item can still be turned into a dish, an item counts as able to become itself
+bool RecipeGraph::CanBecome(ItemId item, ItemId dish) const
+{
+	if (item >= names.size() || dish >= names.size()) return false;
+	if (reachabilityDirty) BuildReachability();
+	return (reachability[item * reachabilityWords + dish / 64] >> (dish % 64)) & 1;
+}
+
+// Flags every item that cannot turn into any of the dishes. Items given as noItem are not part of the recipes and are never flagged
+void RecipeGraph::FindDeadEnds(const std::vector<ItemId>& items, const std::vector<ItemId>& dishes, std::vector<bool>& deadEnds) const
+{
+	if (reachabilityDirty) BuildReachability();
+	MarkDeadEnds(reachability, reachabilityWords, items, dishes, deadEnds);
+}
+
+// Shared with FrozenRecipeGraph, which keeps the closure in the same layout
+void RecipeGraph::MarkDeadEnds(const std::vector<std::uint64_t>& reachability, size_t words, const std::vector<ItemId>& items,
+	const std::vector<ItemId>& dishes, std::vector<bool>& deadEnds)
+{
+	size_t nodeCount = words ? reachability.size() / words : 0;
+
+	// An item is alive if its row shares a bit with the dishes, which costs one row scan per item however many dishes there are
+	std::vector<std::uint64_t> dishMask(words, 0);
+	for (ItemId dish : dishes) {
+		if (dish < nodeCount) dishMask[dish / 64] |= static_cast<std::uint64_t>(1) << (dish % 64);
+	}
+
+	deadEnds.assign(items.size(), false);
+	for (size_t i = 0; i < items.size(); i++) {
+		if (items[i] >= nodeCount) continue;
+
+		const std::uint64_t* row = &reachability[items[i] * words];
+		bool isAlive = false;
+		for (size_t word = 0; word < words && !isAlive; word++) {
+			isAlive = (row[word] & dishMask[word]) != 0;
+		}
+		deadEnds[i] = !isAlive;
+	}
+}
+
+// Computes the transitive closure by ORing every node's row into its sources in depth-first post-order.
+// That is exact in one pass for an acyclic graph, a graph with cycles is repeated until no row changes
+void RecipeGraph::BuildReachability() const
+{
+	size_t nodeCount = names.size();
+	reachabilityWords = (nodeCount + 63) / 64;
+	reachability.assign(nodeCount * reachabilityWords, 0);
+	for (size_t node = 0; node < nodeCount; node++) {
+		reachability[node * reachabilityWords + node / 64] |= static_cast<std::uint64_t>(1) << (node % 64);
+	}
+
+	enum class Visit : std::uint8_t { New, Open, Done };
+	std::vector<Visit> visits(nodeCount, Visit::New);
+	std::vector<ItemId> postOrder;
+	postOrder.reserve(nodeCount);
+	bool hasCycle = false;
+
+	// Each stack entry is a node and the index of the next edge to follow from it
+	std::vector<std::pair<ItemId, size_t>> stack;
+	for (size_t root = 0; root < nodeCount; root++) {
+		if (visits[root] != Visit::New) continue;
+		stack.push_back({ static_cast<ItemId>(root), 0 });
+		visits[root] = Visit::Open;
+
+		while (!stack.empty()) {
+			auto& [node, next] = stack.back();
+			if (next < idGraph[node].size()) {
+				ItemId destination = idGraph[node][next++].destination;
+				if (visits[destination] == Visit::New) {
+					visits[destination] = Visit::Open;
+					stack.push_back({ destination, 0 });
+				}
+				else if (visits[destination] == Visit::Open) hasCycle = true;
+			}
+			else {
+				visits[node] = Visit::Done;
+				postOrder.push_back(node);
+				stack.pop_back();
+			}
+		}
+	}
+
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (ItemId node : postOrder) {
+			std::uint64_t* row = &reachability[node * reachabilityWords];
+			for (const auto& edge : idGraph[node]) {
+				const std::uint64_t* destinationRow = &reachability[edge.destination * reachabilityWords];
+				for (size_t word = 0; word < reachabilityWords; word++) {
+					std::uint64_t merged = row[word] | destinationRow[word];
+					if (merged != row[word]) {
+						row[word] = merged;
+						changed = true;
+					}
+				}
+			}
+		}
+		if (!hasCycle) break;
+	}
+
+	reachabilityDirty = false;
+}
+
+// Finds what a set of ingredients makes, the IDs must be sorted
+MultisetTable::Match RecipeGraph::MatchRecipe(const ItemId* ingredients, size_t count) const
+{
+	if (recipesDirty) BuildRecipes();
+	return recipeTable.Find(ingredients, count);
+}
+
+const std::vector<RecipeGraph::Recipe>& RecipeGraph::GetRecipes() const
+{
+	if (recipesDirty) BuildRecipes();
+	return recipes;
+}
+
+// The most ingredients any recipe takes, which is how many items a plate or counter has to hold
+size_t RecipeGraph::GetMaxRecipeSize() const
+{
+	if (recipesDirty) BuildRecipes();
+	return recipeTable.GetMaxRecipeSize();
+}
+
+// Collects a recipe for every node with two or more edges into it that need no input.
+// A node with a single such edge is not a recipe, putting one item down should never change it
+void RecipeGraph::BuildRecipes() const
+{
+	recipes.clear();
+	recipeTable.Clear();
+
+	std::optional<ItemId> none = GetId("none");
+	if (none) {
+		for (size_t node = 0; node < producers.size(); node++) {
+			std::vector<ItemId> ingredients;
+			for (const auto& producer : producers[node]) {
+				if (producer.input == *none) ingredients.push_back(producer.source);
+			}
+			if (ingredients.size() < 2) continue;
+
+			// Two nodes made from the same ingredients can never both be made, so only the first is kept
+			std::sort(ingredients.begin(), ingredients.end());
+			if (recipeTable.Find(ingredients.data(), ingredients.size()).result != noItem) continue;
+			recipeTable.AddRecipe(ingredients, static_cast<ItemId>(node));
+			recipes.push_back({ std::move(ingredients), static_cast<ItemId>(node) });
+		}
+	}
+
+	recipesDirty = false;
+}
+
+// Finds names only used by edges, loops, items that can never be made and tool inputs used twice from one item
+std::vector<RecipeGraph::Issue> RecipeGraph::Validate() const
+{
+	std::vector<Issue> issues;
+	std::optional<ItemId> none = GetId("none");
+
+	for (size_t id = 0; id < names.size(); id++) {
+		if (!declared[id] && static_cast<ItemId>(id) != none) issues.push_back({ Issue::Kind::UndeclaredName, static_cast<ItemId>(id), noItem });
+	}
+
+	for (size_t node = 0; node < idGraph.size(); node++) {
+		const auto& edges = idGraph[node];
+		for (size_t i = 0; i < edges.size(); i++) {
+			if (edges[i].input == none) continue;
+			for (size_t j = 0; j < i; j++) {
+				if (edges[j].input == edges[i].input) {
+					issues.push_back({ Issue::Kind::DuplicateToolEdge, static_cast<ItemId>(node), edges[i].input });
+					break;
+				}
+			}
+		}
+	}
+
+	// Every edge that closes a loop in a depth-first search over the items left out of the topological order
+	if (topologyDirty) BuildTopology();
+	enum class Visit : std::uint8_t { New, Open, Done };
+	std::vector<Visit> visits(names.size(), Visit::New);
+	for (ItemId node : topologicalOrder) {
+		visits[node] = Visit::Done;
+	}
+
+	std::vector<std::pair<ItemId, size_t>> stack;
+	for (size_t root = 0; root < names.size(); root++) {
+		if (visits[root] != Visit::New) continue;
+		stack.push_back({ static_cast<ItemId>(root), 0 });
+		visits[root] = Visit::Open;
+
+		while (!stack.empty()) {
+			auto& [node, next] = stack.back();
+			if (next < idGraph[node].size()) {
+				ItemId destination = idGraph[node][next++].destination;
+				if (visits[destination] == Visit::New) {
+					visits[destination] = Visit::Open;
+					stack.push_back({ destination, 0 });
+				}
+				else if (visits[destination] == Visit::Open) issues.push_back({ Issue::Kind::Cycle, node, destination });
+			}
+			else {
+				visits[node] = Visit::Done;
+				stack.pop_back();
+			}
+		}
+	}
+
+	for (ItemId node : topologicalOrder) {
+		if (!producers[node].empty() && recipeDepths[node] == noDepth) issues.push_back({ Issue::Kind::UnreachableItem, node, noItem });
+	}
+
+	return issues;
+}
+
+const std::vector<RecipeGraph::ItemId>& RecipeGraph::GetTopologicalOrder() const
+{
+	if (topologyDirty) BuildTopology();
+	return topologicalOrder;
+}
+
+std::uint8_t RecipeGraph::GetRecipeDepth(ItemId item) const
+{
+	if (topologyDirty) BuildTopology();
+	return item < recipeDepths.size() ? recipeDepths[item] : noDepth;
+}
+
+// Orders the items with Kahn's algorithm, then works out depths in that order so every item's producers are done first.
+// An item is made by a tool from one producer or by its recipe from all of them, and takes the cheaper of the two.
+// Depths stop at 254 so they fit in a byte
+void RecipeGraph::BuildTopology() const
+{
+	size_t nodeCount = names.size();
+	std::vector<bool> isInput(nodeCount, false);
+	std::vector<std::uint32_t> unplacedProducers(nodeCount, 0);
+	for (size_t node = 0; node < nodeCount; node++) {
+		for (const auto& edge : idGraph[node]) {
+			isInput[edge.input] = true;
+			unplacedProducers[edge.destination]++;
+		}
+	}
+
+	// Names that were only ever interned, such as a declared tool with no edges yet, are not items either
+	topologicalOrder.clear();
+	for (size_t node = 0; node < nodeCount; node++) {
+		bool isItem = !isInput[node] && (!idGraph[node].empty() || !producers[node].empty() || graph.count(names[node]));
+		if (isItem && unplacedProducers[node] == 0) topologicalOrder.push_back(static_cast<ItemId>(node));
+	}
+	for (size_t next = 0; next < topologicalOrder.size(); next++) {
+		for (const auto& edge : idGraph[topologicalOrder[next]]) {
+			if (--unplacedProducers[edge.destination] == 0) topologicalOrder.push_back(edge.destination);
+		}
+	}
+
+	if (recipesDirty) BuildRecipes();
+	std::vector<const Recipe*> recipeOf(nodeCount, nullptr);
+	for (const auto& recipe : recipes) {
+		recipeOf[recipe.result] = &recipe;
+	}
+
+	recipeDepths.assign(nodeCount, noDepth);
+	std::optional<ItemId> none = GetId("none");
+	for (ItemId node : topologicalOrder) {
+		if (producers[node].empty()) {
+			recipeDepths[node] = 0;
+			continue;
+		}
+
+		int depth = noDepth;
+		for (const auto& producer : producers[node]) {
+			if (producer.input != none && recipeDepths[producer.source] != noDepth && transitions.Get(producer.source, producer.input) == node) {
+				depth = std::min(depth, recipeDepths[producer.source] + 1);
+			}
+		}
+		if (recipeOf[node] != nullptr) {
+			int deepest = 0;
+			for (ItemId ingredient : recipeOf[node]->ingredients) {
+				deepest = std::max(deepest, static_cast<int>(recipeDepths[ingredient]));
+			}
+			if (deepest != noDepth) depth = std::min(depth, deepest + 1);
+		}
+		if (depth != noDepth) recipeDepths[node] = static_cast<std::uint8_t>(std::min(depth, noDepth - 1));
+	}
+
+	topologyDirty = false;
+}
+
+// Estimates the bytes held by the graph, counting each hash map entry as its value plus the allocator's bookkeeping.
+// Strings short enough to be stored inline cost nothing beyond their object
+size_t RecipeGraph::GetMemoryUsage() const
+{
+	auto stringBytes = [](const std::string& text) {
+		return text.capacity() > std::string().capacity() ? text.capacity() + 1 : 0;
+	};
+	const size_t mapEntryOverhead = 2 * sizeof(void*);
+
+	size_t bytes = sizeof(RecipeGraph) + (graph.bucket_count() + ids.bucket_count() + ingredientTrees.bucket_count()) * sizeof(void*);
+	for (const auto& [node, edges] : graph) {
+		bytes += sizeof(std::pair<const std::string, std::vector<Edge>>) + mapEntryOverhead + stringBytes(node);
+		bytes += edges.capacity() * sizeof(Edge);
+		for (const auto& edge : edges) {
+			bytes += stringBytes(edge.destination) + stringBytes(edge.input);
+		}
+	}
+
+	bytes += names.capacity() * sizeof(std::string);
+	for (const auto& name : names) {
+		bytes += stringBytes(name);
+	}
+	for (const auto& [name, id] : ids) {
+		bytes += sizeof(std::pair<const std::string, ItemId>) + mapEntryOverhead + stringBytes(name);
+	}
+
+	bytes += (idGraph.capacity() + producers.capacity() + requiredInputs.capacity()) * sizeof(std::vector<ItemId>);
+	for (size_t node = 0; node < names.size(); node++) {
+		bytes += idGraph[node].capacity() * sizeof(IdEdge) + producers[node].capacity() * sizeof(Producer) +
+			requiredInputs[node].capacity() * sizeof(ItemId);
+	}
+	for (const auto& [dish, tree] : ingredientTrees) {
+		bytes += sizeof(std::pair<const ItemId, std::vector<TreeNode>>) + mapEntryOverhead + tree.capacity() * sizeof(TreeNode);
+	}
+
+	bytes += reachability.capacity() * sizeof(std::uint64_t) + declared.capacity();
+	bytes += topologicalOrder.capacity() * sizeof(ItemId) + recipeDepths.capacity();
+	bytes += recipes.capacity() * sizeof(Recipe) + recipeTable.GetMemoryUsage();
+	for (const auto& recipe : recipes) {
+		bytes += recipe.ingredients.capacity() * sizeof(ItemId);
+	}
+
+	return bytes + GetTableMemoryUsage();
+}
+
+std::shared_ptr<const FrozenRecipeGraph> RecipeGraph::Freeze() const
+{
+	return std::make_shared<const FrozenRecipeGraph>(*this);
+}
+
 void RecipeGraph::PrintGraph() const {
 	for (const auto& pair : graph) {
 		std::cout << pair.first << " -> ";
@@ -28,43 +689,76 @@ void RecipeGraph::PrintGraph() const {
 
 std::string RecipeGraph::FindCommonNode(const std::string& node1, const std::string& node2) const
 {
-	const auto& neighbors1 = GetNeighbors(node1);
-	const auto& neighbors2 = GetNeighbors(node2);
+	std::optional<ItemId> id1 = GetId(node1);
+	std::optional<ItemId> id2 = GetId(node2);
+	if (!id1 || !id2) return "NULL";
 
-	std::unordered_set<std::string> set1;
+	std::optional<ItemId> commonNode = FindCommonNode(*id1, *id2);
+	return commonNode ? GetName(*commonNode) : "NULL";
+}
 
-	for (const auto& neighbor : neighbors1) {
-		set1.insert(neighbor.destination);
-	}
+std::string RecipeGraph::GetInputForEdge(const std::string& from, const std::string& to) const
+{
+	std::optional<ItemId> fromId = GetId(from);
+	std::optional<ItemId> toId = GetId(to);
+	if (!fromId || !toId) return "NULL";
 
-	std::string commonNode = "NULL";
-	for (const auto& neighbor : neighbors2) {
-		if (set1.count(neighbor.destination)) commonNode = neighbor.destination;
-	}
+	std::optional<ItemId> input = GetInputForEdge(*fromId, *toId);
+	return input ? GetName(*input) : "NULL";
+}
 
+std::string RecipeGraph::ApplyInputToNode(const std::string& from, const std::string& input) const
+{
+	std::optional<ItemId> fromId = GetId(from);
+	std::optional<ItemId> inputId = GetId(input);
+	if (!fromId || !inputId) return "NULL";
+
+	std::optional<ItemId> destination = ApplyInputToNode(*fromId, *inputId);
+	return destination ? GetName(*destination) : "NULL";
+}
+
+// Finds a node both nodes lead to with a single table lookup
+std::optional<RecipeGraph::ItemId> RecipeGraph::FindCommonNode(ItemId node1, ItemId node2) const
+{
+	ItemId commonNode = combinations.Get(node1, node2);
+	if (commonNode == PairTable::noItem) return std::nullopt;
 	return commonNode;
 }
 
-std::string RecipeGraph::GetInputForEdge(const std::string& from, const std::string& to) const
+// Finds a node both nodes lead to by walking their edges, preferring the last match in the second node's edges
+std::optional<RecipeGraph::ItemId> RecipeGraph::ScanCommonNode(ItemId node1, ItemId node2) const
 {
-	const auto& neighbors = GetNeighbors(from);
-	for (const auto& neighbor : neighbors) {
-		if (neighbor.destination == to) {
-			return neighbor.input;
+	const auto& neighbors1 = GetNeighbors(node1);
+	const auto& neighbors2 = GetNeighbors(node2);
+
+	// Out-degrees are tiny, so a nested scan beats building a set
+	std::optional<ItemId> commonNode;
+	for (const auto& neighbor2 : neighbors2) {
+		for (const auto& neighbor1 : neighbors1) {
+			if (neighbor1.destination == neighbor2.destination) {
+				commonNode = neighbor2.destination;
+				break;
+			}
 		}
 	}
-	return "NULL";
+
+	return commonNode;
 }
 
-std::string RecipeGraph::ApplyInputToNode(const std::string& from, const std::string& input) const
+std::optional<RecipeGraph::ItemId> RecipeGraph::GetInputForEdge(ItemId from, ItemId to) const
 {
-	const auto& neighbors = GetNeighbors(from);
-
-	for (const auto& neighbor : neighbors) {
-		if (neighbor.input == input) {
-			return neighbor.destination;
+	for (const auto& neighbor : GetNeighbors(from)) {
+		if (neighbor.destination == to) {
+			return neighbor.input;
 		}
 	}
+	return std::nullopt;
+}
 
-	return "NULL";
-}
\ No newline at end of file
+// Finds what a node turns into when an input is applied with a single table lookup
+std::optional<RecipeGraph::ItemId> RecipeGraph::ApplyInputToNode(ItemId from, ItemId input) const
+{
+	ItemId destination = transitions.Get(from, input);
+	if (destination == PairTable::noItem) return std::nullopt;
+	return destination;
+}
@@ -1,32 +1,170 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 #include <unordered_map>
-#include <unordered_set>
 #include <iostream>
+#include "multisetTable.h"
+#include "pairTable.h"
+
+class FrozenRecipeGraph;
 
 class RecipeGraph
 {
 public:
+	// Dense integer handle given to every interned item name and tool input
+	using ItemId = std::uint16_t;
+
+	static constexpr ItemId noItem = PairTable::noItem;
+
 	struct Edge {
 		std::string destination;
 		std::string input;
 	};
 
+	// The same edge, stored with interned IDs for the allocation-free queries
+	struct IdEdge {
+		ItemId destination;
+		ItemId input;
+	};
+
+	// An edge seen from its destination, the source node and the input that turns it into the destination
+	struct Producer {
+		ItemId source;
+		ItemId input;
+	};
+
+	// An item in the expanded ingredient tree of a dish, trees are stored in pre-order
+	struct TreeNode {
+		ItemId item;
+		ItemId input;  // Input that turns this item into its parent, noItem for the dish itself
+		std::uint16_t depth;
+		std::int32_t parent;  // Index of the parent node, -1 for the dish itself
+	};
+
+	// A node made by putting several items together, its ingredients are the sources of every edge into it with no input
+	struct Recipe {
+		std::vector<ItemId> ingredients;  // Sorted, an item appears once for each of its edges into the result
+		ItemId result;
+	};
+
+	// A problem found by Validate
+	struct Issue {
+		enum class Kind : std::uint8_t {
+			UndeclaredName,  // item was only ever named by an edge, which is usually a typo
+			Cycle,  // item can turn back into itself, other is the next item round the loop
+			UnreachableItem,  // item has edges into it but can never be made from raw ingredients
+			DuplicateToolEdge  // item has two edges with the tool input other, and ApplyInputToNode only follows the first
+		};
+
+		Kind kind;
+		ItemId item;
+		ItemId other;  // noItem unless described above
+	};
+
+	static constexpr std::uint8_t noDepth = UINT8_MAX;
+
+	// The game shares one graph through GetInstance, tools and benchmarks may build their own
+	RecipeGraph() = default;
 	static RecipeGraph& GetInstance();
 
-	void AddNode(const std::string& node) { graph[node] = {}; }
-	void AddEdge(const std::string& from, const std::string& to, const std::string& input = "none") { graph[from].push_back({ to, input }); }
+	void AddNode(const std::string& node);
+	void Clear();
+	void AddEdge(const std::string& from, const std::string& to, const std::string& input = "none");
+	size_t ApplyChanges(const RecipeGraph& updated);
 	const std::vector<Edge>& GetNeighbors(const std::string& node) const;
+	const std::vector<IdEdge>& GetNeighbors(ItemId node) const;
 	void PrintGraph() const;
-	
+
+	// Makes an immutable snapshot of the graph that can be shared between threads
+	std::shared_ptr<const FrozenRecipeGraph> Freeze() const;
+
+	// Reverse queries, answered from an index kept next to the forward edges
+	const std::vector<Producer>& GetProducers(ItemId node) const;
+	const std::vector<ItemId>& GetRequiredInputs(ItemId node) const;
+	const std::vector<TreeNode>& GetIngredientTree(ItemId dish) const;
+
+	// Reachability, answered from the transitive closure of the graph, which is rebuilt on the first query after an edge changes
+	bool CanBecome(ItemId item, ItemId dish) const;
+	void FindDeadEnds(const std::vector<ItemId>& items, const std::vector<ItemId>& dishes, std::vector<bool>& deadEnds) const;
+
+	// Recipes of any number of ingredients, built on the first query after an edge changes. Ingredients are
+	// passed as sorted IDs and looked up in a single hash probe, which also reports whether they are part of a recipe
+	MultisetTable::Match MatchRecipe(const ItemId* ingredients, size_t count) const;
+	const std::vector<Recipe>& GetRecipes() const;
+	size_t GetMaxRecipeSize() const;
+
+	// Checks the graph for the mistakes a recipe file can make, an empty result means the graph is sound
+	std::vector<Issue> Validate() const;
+
+	// Topology, built on the first query after an edge changes. The order puts every item after everything it is made from,
+	// and leaves out items on or after a cycle. The depth of an item is the fewest steps from raw ingredients, which are depth 0
+	const std::vector<ItemId>& GetTopologicalOrder() const;
+	std::uint8_t GetRecipeDepth(ItemId item) const;
+
+	// Interning of item names and tool inputs
+	ItemId Intern(const std::string& name);  // Also declares the name, AddEdge interns without declaring
+	std::optional<ItemId> GetId(const std::string& name) const;
+	const std::string& GetName(ItemId id) const { return names[id]; }
+	size_t GetIdCount() const { return names.size(); }
+	std::uint32_t GetRevision() const { return revision; }  // Changes whenever a name or edge is added or removed
+	size_t GetTableMemoryUsage() const { return combinations.GetMemoryUsage() + transitions.GetMemoryUsage(); }
+	size_t GetMemoryUsage() const;
+
 	std::string FindCommonNode(const std::string& node1, const std::string& node2) const;
 	std::string GetInputForEdge(const std::string& from, const std::string& to) const;
 	std::string ApplyInputToNode(const std::string& from, const std::string& input) const;
 
+	std::optional<ItemId> FindCommonNode(ItemId node1, ItemId node2) const;
+	std::optional<ItemId> GetInputForEdge(ItemId from, ItemId to) const;
+	std::optional<ItemId> ApplyInputToNode(ItemId from, ItemId input) const;
+
 private:
-	RecipeGraph() = default;
+	friend class RecipeLoader;  // Reads and writes the compiled form directly
+	friend class FrozenRecipeGraph;  // Copies the edge lists and tables
+
+	ItemId InternName(const std::string& name);
+	void LinkEdge(ItemId from, ItemId to, ItemId input);
+	void RefreshRequiredInputs(ItemId node);
+	std::optional<ItemId> ScanCommonNode(ItemId node1, ItemId node2) const;
+	void BuildReachability() const;
+	void BuildRecipes() const;
+	void BuildTopology() const;
+	static void MarkDeadEnds(const std::vector<std::uint64_t>& reachability, size_t words, const std::vector<ItemId>& items,
+		const std::vector<ItemId>& dishes, std::vector<bool>& deadEnds);
+	void UpdateCombinations(ItemId from, ItemId to);
+	void SetCombination(ItemId first, ItemId second, std::optional<ItemId> result);
+	void RebuildTables();
 
 	std::unordered_map<std::string, std::vector<Edge>> graph;
-};
\ No newline at end of file
+
+	std::vector<std::string> names;  // Indexed by ID
+	std::vector<std::uint8_t> declared;  // Indexed by ID, 1 for names given to AddNode or Intern rather than only named by an edge
+	std::unordered_map<std::string, ItemId> ids;
+	std::vector<std::vector<IdEdge>> idGraph;  // Indexed by the ID of the source node
+	std::vector<std::vector<Producer>> producers;  // Indexed by ID, every edge into the node
+	std::vector<std::vector<ItemId>> requiredInputs;  // Indexed by ID, the distinct tool inputs on the edges into the node
+	mutable std::unordered_map<ItemId, std::vector<TreeNode>> ingredientTrees;  // Expanded on first request, dropped whenever an edge changes
+
+	// One bitset row per node, bit n is set if the node can turn into node n (or is node n)
+	mutable std::vector<std::uint64_t> reachability;
+	mutable size_t reachabilityWords = 0;  // Length of a row in 64-bit words
+	mutable bool reachabilityDirty = true;
+
+	mutable std::vector<Recipe> recipes;  // Ordered by result ID
+	mutable MultisetTable recipeTable;
+	mutable bool recipesDirty = true;
+
+	mutable std::vector<ItemId> topologicalOrder;
+	mutable std::vector<std::uint8_t> recipeDepths;  // Indexed by ID, noDepth for items that cannot be made and for tool inputs
+	mutable bool topologyDirty = true;
+
+	std::uint32_t revision = 0;
+
+	PairTable combinations;  // FindCommonNode result for every pair of nodes, kept up to date by AddEdge
+	PairTable transitions;  // ApplyInputToNode result for every node and input
+	std::shared_ptr<const void> tableStorage;  // Keeps attached table storage, such as a mapped file, alive
+};
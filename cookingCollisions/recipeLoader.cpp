@@ -0,0 +1,354 @@
+#include "recipeLoader.h"
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include "mappedFile.h"
+#include "shippedRecipes.h"
+
+// Removes leading and trailing whitespace
+static std::string Trim(const std::string& text)
+{
+	const char* whitespace = " \t\r\n";
+	size_t start = text.find_first_not_of(whitespace);
+	if (start == std::string::npos) return "";
+	size_t end = text.find_last_not_of(whitespace);
+	return text.substr(start, end - start + 1);
+}
+
+// Loads recipes from the text file, mapping the compiled cache instead whenever it was built from the same text
+bool RecipeLoader::Load(RecipeGraph& recipes, const std::string& textPath, const std::string& cachePath)
+{
+	std::string text;
+	bool hasText = ReadFile(textPath, text);
+	std::uint64_t textHash = HashText(text);
+
+	// A cache shipped without its text file is always trusted
+	if (LoadCompiled(recipes, cachePath, hasText ? &textHash : nullptr)) return true;
+	if (!hasText) return false;
+
+	recipes.Clear();
+	if (!ParseText(recipes, text, textPath)) return false;
+
+	// If the cache cannot be written, e.g. from a read-only install, the next startup just parses again
+	SaveCompiled(Compile(recipes, textHash), cachePath);
+	return true;
+}
+
+// Reads the recipe file again and applies what changed to a graph already in use, then refreshes the cache.
+// If the file cannot be read or has problems, which are reported as when loading, the graph is left as it was
+bool RecipeLoader::Reload(RecipeGraph& recipes, const std::string& textPath, const std::string& cachePath)
+{
+	std::string text;
+	if (!ReadFile(textPath, text)) return false;
+
+	RecipeGraph updated;
+	if (!ParseText(updated, text, textPath)) return false;
+
+	recipes.ApplyChanges(updated);
+
+	SaveCompiled(Compile(updated, HashText(text)), cachePath);
+	return true;
+}
+
+// Builds the recipes compiled into the game in shippedRecipes.h
+void RecipeLoader::LoadShipped(RecipeGraph& recipes)
+{
+	recipes.Clear();
+
+	// Items then inputs, in the order the compile-time tables number them
+	for (auto item : ShippedRecipes::items) {
+		recipes.AddNode(std::string(item));
+	}
+	for (auto input : ShippedRecipes::inputs) {
+		recipes.Intern(std::string(input));
+	}
+
+	for (const auto& edge : ShippedRecipes::edges) {
+		recipes.AddEdge(std::string(edge.from), std::string(edge.to), std::string(edge.input));
+	}
+}
+
+bool RecipeLoader::LoadText(RecipeGraph& recipes, const std::string& path)
+{
+	std::string text;
+	if (!ReadFile(path, text)) return false;
+	return ParseText(recipes, text, path);
+}
+
+// Adds every entry in the text to the graph, reporting malformed lines with their line number
+bool RecipeLoader::ParseText(RecipeGraph& recipes, const std::string& text, const std::string& sourceName)
+{
+	std::istringstream stream(text);
+	std::string line;
+	int lineNumber = 0;
+	bool valid = true;
+	std::unordered_map<std::string, int> firstLines;  // Where each name was first used by an edge, for reporting issues
+
+	while (std::getline(stream, line)) {
+		lineNumber++;
+
+		size_t comment = line.find('#');
+		if (comment != std::string::npos) line.erase(comment);
+		line = Trim(line);
+		if (line.empty()) continue;
+
+		if (line.compare(0, 5, "item ") == 0) {
+			recipes.AddNode(Trim(line.substr(5)));
+			continue;
+		}
+		if (line.compare(0, 6, "input ") == 0) {
+			recipes.Intern(Trim(line.substr(6)));
+			continue;
+		}
+
+		size_t arrow = line.find("->");
+		if (arrow == std::string::npos) {
+			std::cerr << sourceName << ":" << lineNumber << ": expected 'item', 'input' or '<from> -> <to>'" << std::endl;
+			valid = false;
+			continue;
+		}
+
+		std::string from = Trim(line.substr(0, arrow));
+		std::string to = line.substr(arrow + 2);
+		std::string input = "none";
+
+		size_t colon = to.find(':');
+		if (colon != std::string::npos) {
+			input = Trim(to.substr(colon + 1));
+			to.erase(colon);
+		}
+		to = Trim(to);
+
+		if (from.empty() || to.empty() || input.empty()) {
+			std::cerr << sourceName << ":" << lineNumber << ": edge is missing a name" << std::endl;
+			valid = false;
+			continue;
+		}
+
+		for (const std::string* name : { &from, &to, &input }) {
+			firstLines.emplace(*name, lineNumber);
+		}
+		recipes.AddEdge(from, to, input);
+	}
+
+	// Issues with the graph as a whole only make sense once every line was read
+	return valid && ReportIssues(recipes, sourceName, firstLines);
+}
+
+// Prints every issue Validate finds, and returns false if there were any
+bool RecipeLoader::ReportIssues(const RecipeGraph& recipes, const std::string& sourceName, const std::unordered_map<std::string, int>& firstLines)
+{
+	// Issues are reported at the line where their item was first used, or against the whole file
+	auto location = [&](RecipeGraph::ItemId item) {
+		auto it = firstLines.find(recipes.GetName(item));
+		return it != firstLines.end() ? sourceName + ":" + std::to_string(it->second) : sourceName;
+	};
+
+	std::vector<RecipeGraph::Issue> issues = recipes.Validate();
+	for (const auto& issue : issues) {
+		const std::string& name = recipes.GetName(issue.item);
+		switch (issue.kind) {
+		case RecipeGraph::Issue::Kind::UndeclaredName:
+			std::cerr << location(issue.item) << ": '" << name << "' is not declared with an item or input line" << std::endl;
+			break;
+		case RecipeGraph::Issue::Kind::Cycle:
+			std::cerr << location(issue.item) << ": '" << name << "' -> '" << recipes.GetName(issue.other) << "' closes a loop" << std::endl;
+			break;
+		case RecipeGraph::Issue::Kind::UnreachableItem:
+			std::cerr << location(issue.item) << ": '" << name << "' can never be made from raw ingredients" << std::endl;
+			break;
+		case RecipeGraph::Issue::Kind::DuplicateToolEdge:
+			std::cerr << location(issue.item) << ": '" << name << "' has more than one edge for '" << recipes.GetName(issue.other)
+				<< "', only the first is used" << std::endl;
+			break;
+		}
+	}
+
+	return issues.empty();
+}
+
+// Lays the graph out as a single block of bytes that can be mapped back in and used without parsing
+std::vector<unsigned char> RecipeLoader::Compile(const RecipeGraph& recipes, std::uint64_t sourceHash)
+{
+	std::vector<unsigned char> compiled(sizeof(CacheHeader));
+
+	// Appends a section at the next 8-byte boundary and returns its offset
+	auto append = [&compiled](const void* data, size_t size) {
+		compiled.resize((compiled.size() + 7) & ~static_cast<size_t>(7));
+		std::uint32_t offset = static_cast<std::uint32_t>(compiled.size());
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		if (size != 0) compiled.insert(compiled.end(), bytes, bytes + size);
+		return offset;
+	};
+
+	// The string table
+	std::vector<std::uint32_t> nameStarts;
+	std::vector<std::uint8_t> nodeFlags;
+	std::string strings;
+	for (const auto& name : recipes.names) {
+		nameStarts.push_back(static_cast<std::uint32_t>(strings.size()));
+		std::uint8_t flags = recipes.graph.count(name) ? isNodeFlag : 0;
+		if (recipes.declared[nameStarts.size() - 1]) flags |= isDeclaredFlag;
+		nodeFlags.push_back(flags);
+		strings += name;
+	}
+	nameStarts.push_back(static_cast<std::uint32_t>(strings.size()));
+
+	// The edges in CSR form, each node's edges stored contiguously in their original order
+	std::vector<std::uint32_t> edgeStarts;
+	std::vector<RecipeGraph::IdEdge> edges;
+	for (const auto& nodeEdges : recipes.idGraph) {
+		edgeStarts.push_back(static_cast<std::uint32_t>(edges.size()));
+		edges.insert(edges.end(), nodeEdges.begin(), nodeEdges.end());
+	}
+	edgeStarts.push_back(static_cast<std::uint32_t>(edges.size()));
+
+	CacheHeader header{};
+	header.magic = cacheMagic;
+	header.version = cacheVersion;
+	header.sourceHash = sourceHash;
+	header.nameCount = static_cast<std::uint32_t>(recipes.names.size());
+	header.edgeCount = static_cast<std::uint32_t>(edges.size());
+	header.nameStartsOffset = append(nameStarts.data(), nameStarts.size() * sizeof(std::uint32_t));
+	header.stringsOffset = append(strings.data(), strings.size());
+	header.nodeFlagsOffset = append(nodeFlags.data(), nodeFlags.size());
+	header.edgeStartsOffset = append(edgeStarts.data(), edgeStarts.size() * sizeof(std::uint32_t));
+	header.edgesOffset = append(edges.data(), edges.size() * sizeof(RecipeGraph::IdEdge));
+	header.combinations = DescribeTable(recipes.combinations,
+		append(recipes.combinations.GetData(), recipes.combinations.GetDataSize()));
+	header.transitions = DescribeTable(recipes.transitions,
+		append(recipes.transitions.GetData(), recipes.transitions.GetDataSize()));
+	header.fileSize = static_cast<std::uint32_t>(compiled.size());
+
+	std::memcpy(compiled.data(), &header, sizeof(header));
+	return compiled;
+}
+
+bool RecipeLoader::SaveCompiled(const std::vector<unsigned char>& compiled, const std::string& path)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) return false;
+	file.write(reinterpret_cast<const char*>(compiled.data()), static_cast<std::streamsize>(compiled.size()));
+	return static_cast<bool>(file);
+}
+
+// Maps a compiled cache and loads it into the graph, whose tables then read straight from the mapping.
+// Fails if the file is missing, corrupt or was compiled from different text
+bool RecipeLoader::LoadCompiled(RecipeGraph& recipes, const std::string& path, const std::uint64_t* expectedHash)
+{
+	auto file = std::make_shared<MappedFile>(path);
+	if (!file->IsOpen() || file->GetSize() < sizeof(CacheHeader)) return false;
+
+	const unsigned char* data = file->GetData();
+	CacheHeader header;
+	std::memcpy(&header, data, sizeof(header));
+
+	if (header.magic != cacheMagic || header.version != cacheVersion || header.fileSize != file->GetSize()) return false;
+	if (expectedHash != nullptr && header.sourceHash != *expectedHash) return false;
+	if (header.nameCount >= PairTable::noItem) return false;
+
+	// Checks that a section lies entirely inside the file
+	auto inFile = [&header](std::uint32_t offset, size_t size) {
+		return offset <= header.fileSize && size <= header.fileSize - offset;
+	};
+
+	size_t nameCount = header.nameCount;
+	if (!inFile(header.nameStartsOffset, (nameCount + 1) * sizeof(std::uint32_t)) ||
+		!inFile(header.nodeFlagsOffset, nameCount) ||
+		!inFile(header.edgeStartsOffset, (nameCount + 1) * sizeof(std::uint32_t)) ||
+		!inFile(header.edgesOffset, header.edgeCount * sizeof(RecipeGraph::IdEdge)) ||
+		!inFile(header.combinations.offset, header.combinations.size) ||
+		!inFile(header.transitions.offset, header.transitions.size)) return false;
+
+	const auto* nameStarts = reinterpret_cast<const std::uint32_t*>(data + header.nameStartsOffset);
+	const auto* strings = reinterpret_cast<const char*>(data + header.stringsOffset);
+	const auto* nodeFlags = data + header.nodeFlagsOffset;
+	const auto* edgeStarts = reinterpret_cast<const std::uint32_t*>(data + header.edgeStartsOffset);
+	const auto* edges = reinterpret_cast<const RecipeGraph::IdEdge*>(data + header.edgesOffset);
+
+	if (!inFile(header.stringsOffset, nameStarts[nameCount]) || edgeStarts[nameCount] != header.edgeCount) return false;
+	for (size_t i = 0; i < nameCount; i++) {
+		if (nameStarts[i] > nameStarts[i + 1] || edgeStarts[i] > edgeStarts[i + 1]) return false;
+	}
+	for (size_t i = 0; i < header.edgeCount; i++) {
+		if (edges[i].destination >= nameCount || edges[i].input >= nameCount) return false;
+	}
+
+	// Checks that each table's size matches its layout
+	for (const TableHeader* table : { &header.combinations, &header.transitions }) {
+		if (table->hashed && (table->slotBits == 0 || table->slotBits > 31)) return false;
+		size_t expected = table->hashed ? (static_cast<size_t>(1) << table->slotBits) * sizeof(PairTable::Slot)
+			: static_cast<size_t>(table->dimension) * table->dimension * sizeof(PairTable::ItemId);
+		if (table->size != expected) return false;
+	}
+
+	recipes.Clear();
+	recipes.names.reserve(nameCount);
+	recipes.ids.reserve(nameCount);
+	for (size_t i = 0; i < nameCount; i++) {
+		recipes.names.emplace_back(strings + nameStarts[i], nameStarts[i + 1] - nameStarts[i]);
+		if (!recipes.ids.emplace(recipes.names.back(), static_cast<RecipeGraph::ItemId>(i)).second) {
+			recipes.Clear();
+			return false;
+		}
+		recipes.declared.push_back((nodeFlags[i] & isDeclaredFlag) ? 1 : 0);
+		if (nodeFlags[i] & isNodeFlag) recipes.graph[recipes.names.back()];
+	}
+
+	recipes.idGraph.resize(nameCount);
+	recipes.producers.resize(nameCount);
+	recipes.requiredInputs.resize(nameCount);
+	for (size_t from = 0; from < nameCount; from++) {
+		for (std::uint32_t i = edgeStarts[from]; i < edgeStarts[from + 1]; i++) {
+			const auto& edge = edges[i];
+			recipes.LinkEdge(static_cast<RecipeGraph::ItemId>(from), edge.destination, edge.input);
+			recipes.graph[recipes.names[from]].push_back({ recipes.names[edge.destination], recipes.names[edge.input] });
+		}
+	}
+
+	AttachTable(recipes.combinations, header.combinations, data);
+	AttachTable(recipes.transitions, header.transitions, data);
+	recipes.tableStorage = file;
+	return true;
+}
+
+// FNV-1a, used to tell whether a cache was compiled from the current text
+std::uint64_t RecipeLoader::HashText(const std::string& text)
+{
+	std::uint64_t hash = 14695981039346656037ull;
+	for (unsigned char character : text) {
+		hash ^= character;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+bool RecipeLoader::ReadFile(const std::string& path, std::string& contents)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file) return false;
+
+	std::ostringstream buffer;
+	buffer << file.rdbuf();
+	contents = buffer.str();
+	return true;
+}
+
+void RecipeLoader::AttachTable(PairTable& table, const TableHeader& header, const unsigned char* data)
+{
+	PairTable::Layout layout{ header.hashed != 0, header.dimension, header.slotBits };
+	table.Attach(layout, data + header.offset);
+}
+
+RecipeLoader::TableHeader RecipeLoader::DescribeTable(const PairTable& table, std::uint32_t offset)
+{
+	PairTable::Layout layout = table.GetLayout();
+	return {
+		layout.hashed ? 1u : 0u,
+		static_cast<std::uint32_t>(layout.dimension),
+		static_cast<std::uint32_t>(layout.slotBits),
+		offset,
+		static_cast<std::uint32_t>(table.GetDataSize())
+	};
+}
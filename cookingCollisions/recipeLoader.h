@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "recipeGraph.h"
+
+// Loads recipe graphs from the text recipe format, and from the compiled binary cache built from it.
+//
+// Text format, one entry per line, # starts a comment:
+//   item <name>                      an ingredient or dish
+//   input <name>                     a tool input, such as frying pan
+//   <from> -> <to>                   from is combined with the other producers of to
+//   <from> -> <to> : <input>         from turns into to when input is applied
+// A recipe needs every item with a plain edge into it, so recipes can take any number of
+// ingredients, and an item listed twice is needed twice. Every name an edge uses has to be
+// declared, and a file with loops, items that can never be made or an item with two edges
+// for the same tool input is rejected.
+//
+// The binary cache holds the interned string table, the edges as CSR arrays and images of the
+// combination and transition tables. It is memory-mapped and the tables are used in place.
+//
+// Reload reads the text again while the game runs and applies only the changes to the graph in use
+class RecipeLoader
+{
+public:
+	static bool Load(RecipeGraph& recipes, const std::string& textPath, const std::string& cachePath);
+	static void LoadShipped(RecipeGraph& recipes);
+	static bool Reload(RecipeGraph& recipes, const std::string& textPath, const std::string& cachePath);
+
+	static bool LoadText(RecipeGraph& recipes, const std::string& path);
+	static bool ParseText(RecipeGraph& recipes, const std::string& text, const std::string& sourceName);
+
+	static std::vector<unsigned char> Compile(const RecipeGraph& recipes, std::uint64_t sourceHash);
+	static bool SaveCompiled(const std::vector<unsigned char>& compiled, const std::string& path);
+	static bool LoadCompiled(RecipeGraph& recipes, const std::string& path, const std::uint64_t* expectedHash = nullptr);
+
+	static std::uint64_t HashText(const std::string& text);
+
+private:
+	static constexpr std::uint32_t cacheMagic = 0x42504352;  // "RCPB"
+	static constexpr std::uint32_t cacheVersion = 2;
+
+	// Bits of a name's entry in the node flags section
+	static constexpr std::uint8_t isNodeFlag = 1;  // Added to the string-keyed graph
+	static constexpr std::uint8_t isDeclaredFlag = 2;  // Declared by an item or input line rather than only named by an edge
+
+	struct TableHeader {
+		std::uint32_t hashed;
+		std::uint32_t dimension;
+		std::uint32_t slotBits;
+		std::uint32_t offset;
+		std::uint32_t size;
+	};
+
+	// Every offset is in bytes from the start of the file, and every section is 8-byte aligned
+	struct CacheHeader {
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint64_t sourceHash;  // Hash of the text file the cache was compiled from
+		std::uint32_t nameCount;
+		std::uint32_t edgeCount;
+		std::uint32_t nameStartsOffset;  // uint32_t[nameCount + 1], where each name starts in the string bytes
+		std::uint32_t stringsOffset;
+		std::uint32_t nodeFlagsOffset;  // uint8_t[nameCount], a combination of the flags above
+		std::uint32_t edgeStartsOffset;  // uint32_t[nameCount + 1], where each node's edges start
+		std::uint32_t edgesOffset;  // IdEdge[edgeCount], grouped by source node
+		std::uint32_t fileSize;
+		TableHeader combinations;
+		TableHeader transitions;
+	};
+
+	static bool ReadFile(const std::string& path, std::string& contents);
+	static bool ReportIssues(const RecipeGraph& recipes, const std::string& sourceName, const std::unordered_map<std::string, int>& firstLines);
+	static void AttachTable(PairTable& table, const TableHeader& header, const unsigned char* data);
+	static TableHeader DescribeTable(const PairTable& table, std::uint32_t offset);
+};
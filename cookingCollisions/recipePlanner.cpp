@@ -0,0 +1,453 @@
+#include "recipePlanner.h"
+#include <algorithm>
+#include <queue>
+#include <tuple>
+
+size_t RecipePlanner::IdListHash::operator()(const std::vector<ItemId>& ids) const
+{
+	// FNV-1a over the IDs
+	std::uint64_t hash = 14695981039346656037ull;
+	for (ItemId id : ids) {
+		hash ^= id;
+		hash *= 1099511628211ull;
+	}
+	return static_cast<size_t>(hash);
+}
+
+void RecipePlanner::StateHash::Add(ItemId item)
+{
+	if (item >= counts.size()) counts.resize(static_cast<size_t>(item) + 1, 0);
+	hash ^= GetKey(item, ++counts[item]);
+}
+
+void RecipePlanner::StateHash::Remove(ItemId item)
+{
+	if (item >= counts.size() || counts[item] == 0) return;
+	hash ^= GetKey(item, counts[item]--);
+}
+
+// Hashes a multiset from scratch, giving the same result as adding its items one at a time
+std::uint64_t RecipePlanner::StateHash::Of(std::vector<ItemId> items)
+{
+	std::sort(items.begin(), items.end());
+	std::uint64_t hash = 0;
+	std::uint32_t copy = 0;
+	for (size_t i = 0; i < items.size(); i++) {
+		copy = i > 0 && items[i] == items[i - 1] ? copy + 1 : 1;
+		hash ^= GetKey(items[i], copy);
+	}
+	return hash;
+}
+
+// The keys are mixed from the item and copy rather than stored, so the hash works for any number of IDs
+std::uint64_t RecipePlanner::StateHash::GetKey(ItemId item, std::uint32_t copy)
+{
+	std::uint64_t key = (static_cast<std::uint64_t>(item) << 32 | copy) + 0x9E3779B97F4A7C15ull;
+	key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+	key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+	return key ^ (key >> 31);
+}
+
+std::vector<RecipePlanner::ItemId> RecipePlanner::StateHash::GetItems() const
+{
+	std::vector<ItemId> items;
+	for (size_t item = 0; item < counts.size(); item++) {
+		items.insert(items.end(), counts[item], static_cast<ItemId>(item));
+	}
+	return items;
+}
+
+// Drops the costs and cached plans once the recipe graph has changed since they were built
+void RecipePlanner::Refresh()
+{
+	if (revision == recipes.GetRevision()) return;
+	BuildCosts();
+	ClearCache();
+	revision = recipes.GetRevision();
+}
+
+// Works out the cheapest way to make every item, counting one action per pickup, combination and tool use.
+// Every combination and tool use the search can take is a producer of its result, so these costs never
+// overestimate and the heuristic built from them stays admissible
+void RecipePlanner::BuildCosts()
+{
+	size_t count = recipes.GetIdCount();
+	costs.assign(count, unreachable);
+	sources.clear();
+	tools.clear();
+
+	const auto& graphRecipes = recipes.GetRecipes();
+	recipeIndex.assign(count, -1);
+	for (size_t i = 0; i < graphRecipes.size(); i++) {
+		recipeIndex[graphRecipes[i].result] = static_cast<std::int32_t>(i);
+	}
+
+	std::vector<bool> isInput(count, false);
+	for (size_t node = 0; node < count; node++) {
+		for (const auto& edge : recipes.GetNeighbors(static_cast<ItemId>(node))) {
+			isInput[edge.input] = true;
+		}
+	}
+
+	for (size_t node = 0; node < count; node++) {
+		ItemId id = static_cast<ItemId>(node);
+		if (isInput[node]) {
+			if (recipes.GetName(id) != "none") tools.push_back(id);
+		}
+		else if (recipes.GetProducers(id).empty()) {
+			sources.push_back(id);
+			costs[node] = 1;
+		}
+	}
+
+	// Costs only ever fall, so repeating until nothing improves settles even when recipes form a cycle
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (size_t node = 0; node < count; node++) {
+			ItemId id = static_cast<ItemId>(node);
+			const auto& producers = recipes.GetProducers(id);
+			int best = costs[node];
+
+			for (const auto& producer : producers) {
+				if (recipes.ApplyInputToNode(producer.source, producer.input) == id && recipes.GetName(producer.input) != "none") {
+					best = std::min(best, costs[producer.source] + 1);
+				}
+			}
+			if (recipeIndex[node] != -1) {
+				int recipeCost = 1;
+				for (ItemId ingredient : graphRecipes[recipeIndex[node]].ingredients) {
+					recipeCost = std::min(unreachable, recipeCost + costs[ingredient]);
+				}
+				best = std::min(best, recipeCost);
+			}
+
+			if (best < costs[node]) {
+				costs[node] = best;
+				changed = true;
+			}
+		}
+	}
+}
+
+int RecipePlanner::GetRecipeCost(ItemId item)
+{
+	Refresh();
+	return item < costs.size() ? costs[item] : unreachable;
+}
+
+// Collects the rules for everything that can become the target, in depth-first post-order over the producers
+void RecipePlanner::BuildRules(ItemId target)
+{
+	relevant.clear();
+	rules.clear();
+	ruleIngredients.clear();
+	relevantRecipes.clear();
+	rulesCyclic = false;
+	remaining.resize(recipes.GetIdCount(), unreachable);
+	heldCounts.resize(recipes.GetIdCount(), 0);
+
+	enum class Visit : std::uint8_t { New, Open, Done };
+	std::vector<Visit> visits(recipes.GetIdCount(), Visit::New);
+
+	// Each stack entry is a node and the index of the next producer to follow from it
+	std::vector<std::pair<ItemId, size_t>> stack = { { target, 0 } };
+	visits[target] = Visit::Open;
+	while (!stack.empty()) {
+		auto& [node, next] = stack.back();
+		const auto& producers = recipes.GetProducers(node);
+		if (next < producers.size()) {
+			ItemId producer = producers[next++].source;
+			if (visits[producer] == Visit::New) {
+				visits[producer] = Visit::Open;
+				stack.push_back({ producer, 0 });
+			}
+			else if (visits[producer] == Visit::Open) rulesCyclic = true;
+			continue;
+		}
+
+		visits[node] = Visit::Done;
+		relevant.push_back(node);
+		if (std::binary_search(sources.begin(), sources.end(), node)) {
+			rules.push_back({ node, static_cast<std::uint32_t>(ruleIngredients.size()), 0 });
+		}
+		for (const auto& producer : producers) {
+			if (recipes.ApplyInputToNode(producer.source, producer.input) == node && recipes.GetName(producer.input) != "none") {
+				rules.push_back({ node, static_cast<std::uint32_t>(ruleIngredients.size()), 1 });
+				ruleIngredients.push_back(producer.source);
+			}
+		}
+		if (recipeIndex[node] != -1) {
+			const auto& ingredients = recipes.GetRecipes()[recipeIndex[node]].ingredients;
+			rules.push_back({ node, static_cast<std::uint32_t>(ruleIngredients.size()), static_cast<std::uint32_t>(ingredients.size()) });
+			ruleIngredients.insert(ruleIngredients.end(), ingredients.begin(), ingredients.end());
+			relevantRecipes.push_back(recipeIndex[node]);
+		}
+		stack.pop_back();
+	}
+
+	// Rules for one item are next to each other, and each item has at most one recipe
+	recipeOf.resize(recipes.GetIdCount(), -1);
+	for (ItemId node : relevant) {
+		recipeOf[node] = -1;
+	}
+	singleRecipes = !rulesCyclic;
+	for (size_t i = 0; i < rules.size() && singleRecipes; i++) {
+		singleRecipes = recipeOf[rules[i].result] == -1;
+		recipeOf[rules[i].result] = static_cast<std::int32_t>(i);
+	}
+}
+
+// A lower bound on the actions left, found by working out the cost of the target's recipe tree with every
+// item held costing nothing. Held items may be used in several branches at once, which only lowers the
+// estimate, so it never overestimates
+int RecipePlanner::EstimateRemaining(ItemId target, const std::vector<ItemId>& state)
+{
+	if (std::binary_search(state.begin(), state.end(), target)) return 0;
+	if (singleRecipes) return CountTreeActions(target, state);
+
+	for (ItemId node : relevant) {
+		remaining[node] = unreachable;
+	}
+	for (ItemId item : state) {
+		remaining[item] = 0;
+	}
+
+	// Rules come after the rules for their ingredients, so one pass is exact unless the recipes form a cycle
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (const Rule& rule : rules) {
+			int cost = 1;
+			for (std::uint32_t i = 0; i < rule.ingredientCount; i++) {
+				cost = std::min(unreachable, cost + remaining[ruleIngredients[rule.ingredientStart + i]]);
+			}
+			if (cost < remaining[rule.result]) {
+				remaining[rule.result] = cost;
+				changed = true;
+			}
+		}
+		if (!rulesCyclic) break;
+	}
+
+	return std::max(1, remaining[target]);
+}
+
+// The exact number of actions left when every item has one recipe. Walks the target's recipe tree from the top,
+// and each item held covers the first matching branch it meets. Copies of an item have identical branches, and
+// covering an item makes its own ingredients unnecessary, so the first match is always as good as any other
+int RecipePlanner::CountTreeActions(ItemId target, const std::vector<ItemId>& state)
+{
+	for (ItemId item : state) {
+		heldCounts[item]++;
+	}
+
+	int actions = 0;
+	std::vector<ItemId> stack = { target };
+	while (!stack.empty() && actions < unreachable) {
+		ItemId node = stack.back();
+		stack.pop_back();
+
+		if (heldCounts[node] > 0) {
+			heldCounts[node]--;
+			continue;
+		}
+		if (recipeOf[node] == -1) {
+			actions = unreachable;
+			break;
+		}
+
+		const Rule& rule = rules[recipeOf[node]];
+		actions++;
+		for (std::uint32_t i = rule.ingredientCount; i > 0; i--) {
+			stack.push_back(ruleIngredients[rule.ingredientStart + i - 1]);
+		}
+	}
+
+	for (ItemId item : state) {
+		heldCounts[item] = 0;
+	}
+	return actions;
+}
+
+// Returns the shortest plan for making a dish, starting from the items already held
+const std::optional<RecipePlanner::Plan>& RecipePlanner::FindPlan(ItemId target, const std::vector<ItemId>& held)
+{
+	return FindPlan(target, held, StateHash::Of(held));
+}
+
+const std::optional<RecipePlanner::Plan>& RecipePlanner::FindPlan(ItemId target, const std::vector<ItemId>& held, std::uint64_t heldHash)
+{
+	static const std::optional<Plan> noPlan;
+	Refresh();
+	if (target >= costs.size()) return noPlan;
+
+	std::uint64_t heldKey = heldHash ^ StateHash::GetKey(target, 0);
+	if (const std::optional<Plan>* plan = FindCachedPlan(heldKey)) {
+		cacheHits++;
+		return *plan;
+	}
+
+	// Items that cannot become the target are no use to any plan, so they are left out of the state. Plans are also
+	// cached under the state without them, which catches a change to the items held that this target does not care about
+	std::vector<ItemId> start;
+	for (ItemId item : held) {
+		if (recipes.CanBecome(item, target)) start.push_back(item);
+	}
+	std::sort(start.begin(), start.end());
+
+	std::uint64_t startKey = StateHash::Of(start) ^ StateHash::GetKey(target, 0);
+	if (startKey != heldKey) {
+		if (const std::optional<Plan>* plan = FindCachedPlan(startKey)) {
+			cacheHits++;
+			return CachePlan(heldKey, *plan);
+		}
+	}
+
+	cacheMisses++;
+	BuildRules(target);
+	std::optional<Plan> plan = Search(target, std::move(start));
+	if (startKey != heldKey) CachePlan(startKey, plan);
+	return CachePlan(heldKey, std::move(plan));
+}
+
+// Looks a plan up and marks it as the most recently used
+const std::optional<RecipePlanner::Plan>* RecipePlanner::FindCachedPlan(std::uint64_t key)
+{
+	auto it = plans.find(key);
+	if (it == plans.end()) return nullptr;
+	recentPlans.splice(recentPlans.begin(), recentPlans, it->second);
+	return &it->second->plan;
+}
+
+// Adds a plan as the most recently used, dropping the least recently used once the cache is full
+const std::optional<RecipePlanner::Plan>& RecipePlanner::CachePlan(std::uint64_t key, std::optional<Plan> plan)
+{
+	if (plans.size() >= maxCachedPlans) {
+		plans.erase(recentPlans.back().key);
+		recentPlans.pop_back();
+	}
+	recentPlans.push_front({ key, std::move(plan) });
+	plans[key] = recentPlans.begin();
+	return recentPlans.front().plan;
+}
+
+std::optional<RecipePlanner::Plan> RecipePlanner::Search(ItemId target, std::vector<ItemId> start)
+{
+	struct SearchNode {
+		std::vector<ItemId> state;
+		int cost;
+		std::int32_t parent;
+		Step step;
+	};
+
+	std::vector<SearchNode> nodes;
+	std::unordered_map<std::vector<ItemId>, int, IdListHash> bestCosts;
+
+	// Ordered by estimated total, then by cost so far, preferring the deeper of two equal estimates.
+	// Independent actions can be taken in any order, and going deep first avoids expanding every ordering
+	using Entry = std::tuple<int, int, std::int32_t>;
+	auto compare = [](const Entry& a, const Entry& b) {
+		if (std::get<0>(a) != std::get<0>(b)) return std::get<0>(a) > std::get<0>(b);
+		return std::get<1>(a) < std::get<1>(b);
+	};
+	std::priority_queue<Entry, std::vector<Entry>, decltype(compare)> open(compare);
+
+	// Returns true if the new state keeps the estimated total of its parent, so it lies on a shortest plan
+	auto push = [&](std::vector<ItemId> state, int cost, std::int32_t parent, Step step, int parentEstimate) {
+		auto best = bestCosts.find(state);
+		if (best != bestCosts.end() && best->second <= cost) return false;
+		bestCosts[state] = cost;
+
+		int estimate = cost + EstimateRemaining(target, state);
+		nodes.push_back({ std::move(state), cost, parent, step });
+		open.emplace(estimate, cost, static_cast<std::int32_t>(nodes.size() - 1));
+		return estimate == parentEstimate;
+	};
+
+	// Replaces the given item of a state with a result, keeping the state sorted
+	auto replace = [](const std::vector<ItemId>& state, size_t item, ItemId result) {
+		std::vector<ItemId> next;
+		next.reserve(state.size() + 1);
+		for (size_t i = 0; i < state.size(); i++) {
+			if (i != item) next.push_back(state[i]);
+		}
+		next.insert(std::upper_bound(next.begin(), next.end(), result), result);
+		return next;
+	};
+
+	// Replaces a recipe's ingredients with its result. Both lists are sorted, so one merge finds whether the state holds them all
+	auto combine = [](const std::vector<ItemId>& state, const std::vector<ItemId>& ingredients, ItemId result) {
+		std::optional<std::vector<ItemId>> next = std::vector<ItemId>();
+		next->reserve(state.size());
+		size_t used = 0;
+		for (ItemId item : state) {
+			if (used < ingredients.size() && ingredients[used] == item) used++;
+			else next->push_back(item);
+		}
+		if (used < ingredients.size()) return std::optional<std::vector<ItemId>>();
+		next->insert(std::upper_bound(next->begin(), next->end(), result), result);
+		return next;
+	};
+
+	// Queues every state one action on from a state. The estimate is exact when every item has one recipe, so
+	// the first state that keeps the estimated total is already on a shortest plan and the rest are not needed
+	auto expand = [&](const std::vector<ItemId>& state, int cost, std::int32_t index, int estimate) {
+		for (size_t i = 0; i < state.size(); i++) {
+			if (i > 0 && state[i] == state[i - 1]) continue;  // Copies of an item lead to the same states
+
+			for (ItemId tool : tools) {
+				std::optional<ItemId> result = recipes.ApplyInputToNode(state[i], tool);
+				if (result && recipes.CanBecome(*result, target)) {
+					Step step = { Action::UseTool, state[i], tool, *result, {} };
+					if (push(replace(state, i, *result), cost + 1, index, step, estimate) && singleRecipes) return;
+				}
+			}
+		}
+
+		for (std::int32_t recipe : relevantRecipes) {
+			const RecipeGraph::Recipe& combination = recipes.GetRecipes()[recipe];
+			if (combination.ingredients.size() > state.size()) continue;
+			std::optional<std::vector<ItemId>> next = combine(state, combination.ingredients, combination.result);
+			if (next) {
+				Step step = { Action::Combine, RecipeGraph::noItem, RecipeGraph::noItem, combination.result, combination.ingredients };
+				if (push(std::move(*next), cost + 1, index, step, estimate) && singleRecipes) return;
+			}
+		}
+
+		for (ItemId source : sources) {
+			if (recipes.CanBecome(source, target)) {
+				Step step = { Action::Pickup, source, RecipeGraph::noItem, source, {} };
+				if (push(replace(state, SIZE_MAX, source), cost + 1, index, step, estimate) && singleRecipes) return;
+			}
+		}
+	};
+
+	lastExpansions = 0;
+	int startEstimate = EstimateRemaining(target, start);
+	if (startEstimate >= unreachable) return std::nullopt;
+	push(std::move(start), 0, -1, {}, startEstimate);
+
+	while (!open.empty() && lastExpansions < maxExpansions) {
+		auto [estimate, cost, index] = open.top();
+		open.pop();
+		// A cheaper route to this state was found after this entry was queued. The estimate can fall by more than one
+		// action at a time, so states are reopened rather than closed on their first expansion
+		if (bestCosts[nodes[index].state] < cost) continue;
+		lastExpansions++;
+
+		// Copied, as pushing can move the node storage
+		std::vector<ItemId> state = nodes[index].state;
+		if (std::binary_search(state.begin(), state.end(), target)) {
+			Plan plan;
+			for (std::int32_t node = index; nodes[node].parent != -1; node = nodes[node].parent) {
+				plan.push_back(nodes[node].step);
+			}
+			std::reverse(plan.begin(), plan.end());
+			return plan;
+		}
+		expand(state, cost, index, estimate);
+	}
+
+	return std::nullopt;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "recipeGraph.h"
+
+// Finds the shortest sequence of pickups, combinations and tool uses that makes a dish.
+// Searches with A* over the multiset of items held, and keeps the most recently used plans,
+// keyed by a Zobrist hash of the items and the dish, until the recipe graph changes
+class RecipePlanner
+{
+public:
+	using ItemId = RecipeGraph::ItemId;
+
+	enum class Action : std::uint8_t {
+		Pickup,  // Takes a new raw ingredient
+		Combine,  // Puts every ingredient of a recipe together
+		UseTool  // Chops, fries or boils an item, depending on the tool input
+	};
+
+	// One action of a plan
+	struct Step {
+		Action action;
+		ItemId item;  // The ingredient picked up or the item the tool is used on, noItem for Combine
+		ItemId tool;  // The tool input for UseTool, noItem otherwise
+		ItemId result;
+		std::vector<ItemId> ingredients;  // The sorted items put together for Combine, empty otherwise
+	};
+
+	using Plan = std::vector<Step>;
+
+	// Zobrist hash of a multiset of items, updated as items come and go instead of being hashed again.
+	// Every copy of an item has its own key, so the hash only depends on how many of each item there are
+	class StateHash
+	{
+	public:
+		void Add(ItemId item);
+		void Remove(ItemId item);
+		void Clear() { hash = 0; counts.clear(); }
+
+		static std::uint64_t Of(std::vector<ItemId> items);
+		static std::uint64_t GetKey(ItemId item, std::uint32_t copy);  // Copy 0 is never in a multiset, and marks the target of a plan
+
+		// Getters
+		std::uint64_t Get() const { return hash; }
+		std::vector<ItemId> GetItems() const;
+
+	private:
+		std::uint64_t hash = 0;
+		std::vector<std::uint32_t> counts;  // Indexed by ID
+	};
+
+	RecipePlanner(const RecipeGraph& recipes) : recipes(recipes) {}
+
+	// Returns nothing if the dish cannot be made from the items held and raw ingredients. The plan stays valid until
+	// the next call. Callers that keep a StateHash of what they hold pass its hash, so asking again about the same
+	// items costs one probe of the cache
+	const std::optional<Plan>& FindPlan(ItemId target, const std::vector<ItemId>& held = {});
+	const std::optional<Plan>& FindPlan(ItemId target, const std::vector<ItemId>& held, std::uint64_t heldHash);
+	void ClearCache() { plans.clear(); recentPlans.clear(); }
+
+	// The fewest actions needed to make an item from nothing, used as the search heuristic
+	int GetRecipeCost(ItemId item);
+
+	// Getters
+	size_t GetCachedPlanCount() const { return plans.size(); }
+	size_t GetCacheHits() const { return cacheHits; }
+	size_t GetCacheMisses() const { return cacheMisses; }
+	size_t GetLastExpansions() const { return lastExpansions; }
+
+private:
+	static constexpr int unreachable = INT32_MAX / 4;
+	static constexpr size_t maxExpansions = 200000;  // Gives up on a search rather than stalling the frame
+	static constexpr size_t maxCachedPlans = 4096;  // The least recently used plan is dropped beyond this
+
+	// Hashes a sorted list of IDs, which is how search states are stored
+	struct IdListHash {
+		size_t operator()(const std::vector<ItemId>& ids) const;
+	};
+
+	// One way of making an item, from no ingredients for a raw ingredient, one for a tool use, or a recipe's worth
+	struct Rule {
+		ItemId result;
+		std::uint32_t ingredientStart;  // Where the ingredients start in ruleIngredients
+		std::uint32_t ingredientCount;
+	};
+
+	// A plan and the key it was cached under, the state's hash combined with the target's
+	struct CachedPlan {
+		std::uint64_t key;
+		std::optional<Plan> plan;
+	};
+
+	void Refresh();
+	const std::optional<Plan>* FindCachedPlan(std::uint64_t key);
+	const std::optional<Plan>& CachePlan(std::uint64_t key, std::optional<Plan> plan);
+	void BuildCosts();
+	void BuildRules(ItemId target);
+	std::optional<Plan> Search(ItemId target, std::vector<ItemId> start);
+	int EstimateRemaining(ItemId target, const std::vector<ItemId>& state);
+	int CountTreeActions(ItemId target, const std::vector<ItemId>& state);
+
+	const RecipeGraph& recipes;
+	std::uint32_t revision = UINT32_MAX;  // Revision of the graph the costs and plans were built from
+
+	std::vector<int> costs;  // Indexed by ID
+	std::vector<ItemId> sources;  // Raw ingredients, which have no producers and are not tool inputs
+	std::vector<ItemId> tools;  // Every tool input other than none
+	std::vector<std::int32_t> recipeIndex;  // Index into the graph's recipes of the recipe for each item, or -1, indexed by ID
+
+	// Every item that can become the target being searched, and the rules for making them with producers before products
+	std::vector<ItemId> relevant;
+	std::vector<Rule> rules;
+	std::vector<ItemId> ruleIngredients;
+	std::vector<std::int32_t> relevantRecipes;  // The recipes making relevant items, which are the only combinations a search tries
+	bool rulesCyclic = false;
+	bool singleRecipes = false;  // Set when every relevant item has exactly one recipe, which makes the estimate exact
+	std::vector<std::int32_t> recipeOf;  // Index of the rule for each relevant item when singleRecipes is set, indexed by ID
+	std::vector<int> remaining;  // Scratch for the relaxed estimate, indexed by ID
+	std::vector<int> heldCounts;  // Scratch for the exact estimate, indexed by ID and left at zero between calls
+
+	std::list<CachedPlan> recentPlans;  // Most recently used first
+	std::unordered_map<std::uint64_t, std::list<CachedPlan>::iterator> plans;
+	size_t lastExpansions = 0;
+	size_t cacheHits = 0;
+	size_t cacheMisses = 0;
+};
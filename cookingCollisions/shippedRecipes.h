@@ -0,0 +1,53 @@
+#pragma once
+
+#include "staticRecipeGraph.h"
+
+// The recipes shipped with the game, used when staticRecipes is set in config.h or assets/recipes.txt is missing.
+// Kept in step with assets/recipes.txt, and graph holds the same recipes as compile-time tables
+namespace ShippedRecipes
+{
+	// Every ingredient and dish, these become the nodes of the graph
+	constexpr std::array<std::string_view, 19> items = { "sweet crystal", "spice particle", "energy particle", "liquid essence",
+		"protein orb", "vegetable core", "aroma sphere", "cooling shard", "caramel essence", "frozen spice mix",
+		"protein veg mix", "spiced liquid", "sugar shards", "icy sweet mix", "caramel energy cube",
+		"spicy frost bomb", "protein salad", "liquid flame soup", "frosted energy treat" };
+
+	// Inputs that can be applied along an edge, "none" meaning the edge is a plain combination
+	constexpr std::array<std::string_view, 4> inputs = { "none", "frying pan", "chopping board", "saucepan" };
+
+	// Edges between nodes with an input, which indicate what can be turned into what, and how
+	constexpr std::array<StaticEdge, 18> edges = { {
+		{ "sweet crystal", "caramel essence", "frying pan" },
+		{ "caramel essence", "caramel energy cube" },
+		{ "energy particle", "caramel energy cube" },
+
+		{ "spice particle", "frozen spice mix" },
+		{ "cooling shard", "frozen spice mix" },
+		{ "frozen spice mix", "spicy frost bomb", "chopping board" },
+
+		{ "protein orb", "protein veg mix" },
+		{ "vegetable core", "protein veg mix" },
+		{ "protein veg mix", "protein salad" },
+		{ "aroma sphere", "protein salad" },
+
+		{ "liquid essence", "spiced liquid" },
+		{ "spice particle", "spiced liquid" },
+		{ "spiced liquid", "liquid flame soup", "frying pan" },
+
+		{ "sweet crystal", "sugar shards", "chopping board" },
+		{ "sugar shards", "icy sweet mix" },
+		{ "cooling shard", "icy sweet mix" },
+		{ "icy sweet mix", "frosted energy treat" },
+		{ "energy particle", "frosted energy treat" },
+	} };
+
+	constexpr StaticRecipeGraph<items.size(), inputs.size(), edges.size()> graph(items, inputs, edges);
+
+	static_assert(graph.HasUniqueNames(), "An item or input is listed twice");
+	static_assert(graph.FindCommonNode(graph.GetId("caramel essence"), graph.GetId("energy particle")) == graph.GetId("caramel energy cube"),
+		"Combination table was not built at compile time");
+	static_assert(graph.ApplyInputToNode(graph.GetId("sweet crystal"), graph.GetId("chopping board")) == graph.GetId("sugar shards"),
+		"Transition table was not built at compile time");
+	static_assert(graph.GetMaxRecipeSize() <= 2,
+		"BaseItem::MatchIngredients folds pairs to the combination table, recipes of more ingredients have to be loaded from assets/recipes.txt");
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Refers to a value in a slot map. A handle whose value has been removed stays stale even after its slot is reused,
+// because every removal bumps the slot's generation
+struct SlotHandle {
+	static constexpr std::uint32_t noIndex = UINT32_MAX;
+
+	std::uint32_t index = noIndex;
+	std::uint32_t generation = 0;
+
+	bool IsNull() const { return index == noIndex; }
+	bool operator==(const SlotHandle& other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+// Keeps values in a dense array, so iterating over them never skips holes, and addresses them through generational
+// handles. Inserting, finding and removing are all O(1), removing moves the last value into the hole it leaves
+template<typename T>
+class SlotMap
+{
+public:
+	SlotHandle Insert(const T& value)
+	{
+		std::uint32_t index;
+		if (freeSlot != SlotHandle::noIndex) {
+			index = freeSlot;
+			freeSlot = slots[index].position;
+		}
+		else {
+			index = static_cast<std::uint32_t>(slots.size());
+			slots.push_back({});
+		}
+
+		slots[index].position = static_cast<std::uint32_t>(values.size());
+		values.push_back(value);
+		valueSlots.push_back(index);
+		return { index, slots[index].generation };
+	}
+
+	// Returns false if the handle was already stale
+	bool Remove(SlotHandle handle)
+	{
+		if (!Contains(handle)) return false;
+
+		// Moves the last value into the removed one's place
+		Slot& slot = slots[handle.index];
+		std::uint32_t lastSlot = valueSlots.back();
+		values[slot.position] = values.back();
+		valueSlots[slot.position] = lastSlot;
+		slots[lastSlot].position = slot.position;
+		values.pop_back();
+		valueSlots.pop_back();
+
+		slot.generation++;
+		slot.position = freeSlot;
+		freeSlot = handle.index;
+		return true;
+	}
+
+	static constexpr size_t npos = SIZE_MAX;
+
+	// Returns nullptr for stale handles
+	T* Find(SlotHandle handle) { return Contains(handle) ? &values[slots[handle.index].position] : nullptr; }
+	const T* Find(SlotHandle handle) const { return Contains(handle) ? &values[slots[handle.index].position] : nullptr; }
+
+	// Where a handle's value is in GetValues, or npos for stale handles. Removing a value moves the last one, so
+	// anything kept in step with the values has to move its last entry into the same place
+	size_t GetPosition(SlotHandle handle) const { return Contains(handle) ? slots[handle.index].position : npos; }
+
+	bool Contains(SlotHandle handle) const
+	{
+		return handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+	}
+
+	// Removes every value, leaving every handle given out so far stale
+	void Clear()
+	{
+		for (std::uint32_t index : valueSlots) slots[index].generation++;
+		values.clear();
+		valueSlots.clear();
+
+		freeSlot = SlotHandle::noIndex;
+		for (size_t index = slots.size(); index-- > 0;) {
+			slots[index].position = freeSlot;
+			freeSlot = static_cast<std::uint32_t>(index);
+		}
+	}
+
+	// Getters
+	const std::vector<T>& GetValues() const { return values; }
+	size_t GetSize() const { return values.size(); }
+
+private:
+	struct Slot {
+		std::uint32_t generation = 0;
+		std::uint32_t position = 0;  // Where the slot's value is in values, or the next free slot while it is free
+	};
+
+	std::vector<Slot> slots;
+	std::vector<T> values;  // Dense, in no particular order
+	std::vector<std::uint32_t> valueSlots;  // The slot of each value, so the value moved by a removal can be found
+	std::uint32_t freeSlot = SlotHandle::noIndex;
+};
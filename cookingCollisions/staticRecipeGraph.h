@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "perfectHash.h"
+
+// An edge of a compile-time recipe graph, written with names and resolved to IDs by StaticRecipeGraph
+struct StaticEdge {
+	std::string_view from;
+	std::string_view to;
+	std::string_view input = "none";
+};
+
+// A recipe graph whose combination and transition tables are built entirely at compile time.
+// A misspelt name in an edge indexes out of range and fails to compile, and names are found with a compile-time perfect hash.
+// IDs are assigned in the order items then inputs, the same order RecipeGraph interns them in
+// when it is built from the same arrays, so IDs can be passed freely between the two
+template <size_t ItemCount, size_t InputCount, size_t EdgeCount>
+class StaticRecipeGraph
+{
+public:
+	using ItemId = std::uint16_t;
+
+	static constexpr ItemId noItem = UINT16_MAX;
+	static constexpr size_t nameCount = ItemCount + InputCount;
+
+	constexpr StaticRecipeGraph(const std::array<std::string_view, ItemCount>& items,
+		const std::array<std::string_view, InputCount>& inputs, const std::array<StaticEdge, EdgeCount>& edges) :
+		nameIndex(PerfectHashing::JoinNames(items, inputs))
+	{
+		for (auto& row : combinations) {
+			for (auto& result : row) result = noItem;
+		}
+		for (auto& row : transitions) {
+			for (auto& result : row) result = noItem;
+		}
+
+		// Two nodes combine into a shared destination, later edges of the second node take precedence as in RecipeGraph
+		for (const auto& edge2 : edges) {
+			for (const auto& edge1 : edges) {
+				if (edge1.to == edge2.to) {
+					combinations[GetId(edge1.from)][GetId(edge2.from)] = GetId(edge2.to);
+				}
+			}
+		}
+
+		// Applying an input follows the first matching edge, as in RecipeGraph
+		for (const auto& edge : edges) {
+			ItemId input = GetId(edge.input);
+			if (input < ItemCount) continue;
+			ItemId& result = transitions[GetId(edge.from)][input - ItemCount];
+			if (result == noItem) result = GetId(edge.to);
+		}
+
+		// A recipe takes one ingredient for each edge with no input into its result
+		for (const auto& edge : edges) {
+			size_t ingredientCount = 0;
+			for (const auto& other : edges) {
+				if (other.to == edge.to && other.input == "none") ingredientCount++;
+			}
+			if (ingredientCount > maxRecipeSize) maxRecipeSize = ingredientCount;
+		}
+	}
+
+	// Returns noItem for unknown names
+	constexpr ItemId GetId(std::string_view name) const
+	{
+		size_t index = nameIndex.Find(name);
+		return index == nameIndex.npos ? noItem : static_cast<ItemId>(index);
+	}
+
+	constexpr std::string_view GetName(ItemId id) const { return nameIndex.GetName(id); }
+	constexpr bool HasUniqueNames() const { return nameIndex.IsBuilt(); }
+	constexpr size_t GetMaxRecipeSize() const { return maxRecipeSize; }
+
+	constexpr ItemId FindCommonNode(ItemId node1, ItemId node2) const
+	{
+		if (node1 >= nameCount || node2 >= nameCount) return noItem;
+		return combinations[node1][node2];
+	}
+
+	constexpr ItemId ApplyInputToNode(ItemId from, ItemId input) const
+	{
+		if (from >= nameCount || input < ItemCount || input >= nameCount) return noItem;
+		return transitions[from][input - ItemCount];
+	}
+
+private:
+	StaticPerfectHash<nameCount> nameIndex;
+	std::array<std::array<ItemId, nameCount>, nameCount> combinations{};
+	std::array<std::array<ItemId, InputCount>, nameCount> transitions{};
+	size_t maxRecipeSize = 0;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "itemStore.h"
+
+// The tools that work on items placed on them, indexed into the station table
+enum class Station : std::uint8_t {
+	ChoppingBoard,
+	FryingPan,
+	Saucepan
+};
+
+constexpr size_t stationCount = 3;
+
+// What a tool does to the item in its first slot. The tool input of each station is resolved against the recipes
+// in use, so a station works on whatever the recipes say applying its input to an item makes
+struct StationInfo {
+	std::string_view input;  // The tool input in the recipes
+	ItemState result;  // What processing an item does to it, which picks its texture
+	float duration;  // Seconds an item spends on the station, unused by stations that need interaction
+	bool needsInteraction;  // Processes an item when the player uses the station, rather than after the duration
+	std::string_view sound;  // Played when an item starts or finishes processing, empty for none
+};
+
+// Adding a station means adding its row here and to Station, nothing else looks at which station is which
+constexpr std::array<StationInfo, stationCount> stationTable = { {
+	{ "chopping board", ItemState::Chopped, 0.f, true, "chopping" },
+	{ "frying pan", ItemState::Cooked, 5.f, false, "frying" },
+	{ "saucepan", ItemState::Cooked, 8.f, false, "" }
+} };
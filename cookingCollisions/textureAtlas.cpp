@@ -0,0 +1,184 @@
+#include "textureAtlas.h"
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+TextureAtlas::TextureAtlas(int pageSize, int maxSpriteSize, int padding) :
+	pageSize(pageSize), maxSpriteSize(maxSpriteSize), padding(padding)
+{
+	// Padded sizes are rounded up to the padding, so the largest sprite has to fit a page after rounding
+	this->maxSpriteSize = std::min(maxSpriteSize, pageSize / padding * padding - 2 * padding);
+
+	// Each mipmap level halves the border, past log2(padding) + 1 levels a texel would blend neighbouring sprites
+	while ((1 << mipmapCount) <= padding) mipmapCount++;
+}
+
+// Loads an image to be packed by the next Build, returning the index of its sprite or npos if it could not be loaded
+size_t TextureAtlas::Add(const std::string& path)
+{
+	Image image = LoadImage(path.c_str());
+	if (image.data == nullptr) {
+		std::cerr << "Could not load " << path << std::endl;
+		return npos;
+	}
+
+	// Scales the image down to the largest size it is drawn at, keeping its shape
+	int largest = std::max(image.width, image.height);
+	if (largest > maxSpriteSize) {
+		ImageResize(&image, std::max(1, image.width * maxSpriteSize / largest), std::max(1, image.height * maxSpriteSize / largest));
+	}
+
+	ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+	ImageAlphaPremultiply(&image);  // Multiplies all RGB values by the alpha channel to ensure smoother blending
+
+	images.push_back(image);
+	imagePaths.push_back(path);
+	sprites.push_back({});
+	return sprites.size() - 1;
+}
+
+// Packs every image added since the last build into new pages and uploads them, filling in their sprites
+void TextureAtlas::Build()
+{
+	if (images.empty()) return;
+	size_t firstSprite = sprites.size() - images.size();
+
+	// Packing the tallest images first leaves the flattest skyline
+	std::vector<size_t> order(images.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return images[a].height > images[b].height; });
+
+	std::vector<Image> pageImages;
+	std::vector<std::vector<Segment>> skylines;
+	std::vector<size_t> spritePages(images.size());
+
+	for (size_t index : order) {
+		const Image& image = images[index];
+
+		// Padded sizes are rounded up to the padding, so every sprite starts on the padding grid
+		int width = (image.width + 2 * padding + padding - 1) / padding * padding;
+		int height = (image.height + 2 * padding + padding - 1) / padding * padding;
+
+		// Puts the image on the first page with room for it, starting a page when none has
+		int x = 0, y = 0;
+		size_t page = 0;
+		while (page < skylines.size() && !FindPlace(skylines[page], width, height, x, y)) page++;
+		if (page == skylines.size()) {
+			std::vector<Segment> skyline = { { 0, 0, pageSize } };
+			if (!FindPlace(skyline, width, height, x, y)) {
+				std::cerr << imagePaths[index] << " does not fit an atlas page with its padding and is left out" << std::endl;
+				spritePages[index] = npos;
+				continue;
+			}
+			pageImages.push_back(GenImageColor(pageSize, pageSize, BLANK));
+			skylines.push_back(std::move(skyline));
+		}
+
+		Raise(skylines[page], x, y, width, height);
+		CopyPadded(pageImages[page], image, x, y);
+		spritePages[index] = pages.size() + page;
+		sprites[firstSprite + index].source = {
+			static_cast<float>(x + padding), static_cast<float>(y + padding),
+			static_cast<float>(image.width), static_cast<float>(image.height) };
+	}
+
+	for (Image& pageImage : pageImages) {
+		ImageMipmaps(&pageImage);  // Generates images pre-scaled to different sizes for scaling
+		pageImage.mipmaps = std::min(pageImage.mipmaps, mipmapCount);  // Only the levels the padding keeps apart are uploaded
+		Texture2D texture = LoadTextureFromImage(pageImage);  // Loads the texture from the image so that it can be used by the GPU
+		SetTextureFilter(texture, TEXTURE_FILTER_TRILINEAR);  // Applies trilinear filtering for smooth interpolation for scaled textures
+		UnloadImage(pageImage);
+		pages.push_back(texture);
+	}
+
+	for (size_t index = 0; index < images.size(); index++) {
+		if (spritePages[index] != npos) sprites[firstSprite + index].texture = pages[spritePages[index]];
+		UnloadImage(images[index]);
+	}
+	images.clear();
+	imagePaths.clear();
+}
+
+// Unloads every page and drops every sprite, including images still waiting to be packed
+void TextureAtlas::Unload()
+{
+	for (Image& image : images) UnloadImage(image);
+	for (Texture2D& page : pages) UnloadTexture(page);
+	images.clear();
+	imagePaths.clear();
+	sprites.clear();
+	pages.clear();
+}
+
+// Returns a sprite, or an empty one for npos and for sprites that have not been packed yet
+const Sprite& TextureAtlas::GetSprite(size_t index) const
+{
+	static const Sprite noSprite{};
+	return index < sprites.size() ? sprites[index] : noSprite;
+}
+
+// Finds the lowest place on a skyline a rectangle fits, leftmost of the lowest. Returns false if it fits nowhere
+bool TextureAtlas::FindPlace(const std::vector<Segment>& skyline, int width, int height, int& bestX, int& bestY) const
+{
+	bool found = false;
+	for (size_t first = 0; first < skyline.size(); first++) {
+		int x = skyline[first].x;
+		if (x + width > pageSize) break;
+
+		// The rectangle rests on the highest segment under it
+		int y = 0;
+		int covered = 0;
+		for (size_t segment = first; covered < width; segment++) {
+			y = std::max(y, skyline[segment].y);
+			covered = skyline[segment].x + skyline[segment].width - x;
+		}
+
+		if (y + height <= pageSize && (!found || y < bestY)) {
+			found = true;
+			bestX = x;
+			bestY = y;
+		}
+	}
+	return found;
+}
+
+// Raises the skyline over a placed rectangle, merging it with the segments it covers
+void TextureAtlas::Raise(std::vector<Segment>& skyline, int x, int y, int width, int height)
+{
+	std::vector<Segment> raised;
+	raised.reserve(skyline.size() + 2);
+
+	for (const Segment& segment : skyline) {
+		int end = segment.x + segment.width;
+
+		// Keeps the parts of the segment either side of the rectangle
+		if (segment.x < x) raised.push_back({ segment.x, segment.y, std::min(end, x) - segment.x });
+		if (segment.x <= x && end > x) raised.push_back({ x, y + height, width });
+		if (end > x + width) {
+			int start = std::max(segment.x, x + width);
+			raised.push_back({ start, segment.y, end - start });
+		}
+	}
+
+	// Joins neighbours at the same height
+	skyline.clear();
+	for (const Segment& segment : raised) {
+		if (!skyline.empty() && skyline.back().y == segment.y) skyline.back().width += segment.width;
+		else skyline.push_back(segment);
+	}
+}
+
+// Copies an image onto a page with its edge pixels repeated out over its padding
+void TextureAtlas::CopyPadded(Image& page, const Image& image, int x, int y) const
+{
+	Color* pagePixels = static_cast<Color*>(page.data);
+	const Color* imagePixels = static_cast<const Color*>(image.data);
+
+	for (int row = -padding; row < image.height + padding; row++) {
+		int sourceRow = std::clamp(row, 0, image.height - 1);
+		for (int column = -padding; column < image.width + padding; column++) {
+			int sourceColumn = std::clamp(column, 0, image.width - 1);
+			pagePixels[(y + padding + row) * pageSize + x + padding + column] = imagePixels[sourceRow * image.width + sourceColumn];
+		}
+	}
+}
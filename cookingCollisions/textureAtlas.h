@@ -0,0 +1,58 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// A picture in an atlas page. Sprites with no texture are not drawn
+struct Sprite {
+	Texture2D texture{};  // The page the sprite is on, shared with every other sprite on it
+	Rectangle source{};  // Where the sprite is on the page
+
+	bool IsLoaded() const { return texture.id != 0; }
+};
+
+// Packs images into a few large pages at load time, so everything drawn from one page shares a texture and raylib
+// draws it in one batch. Images are placed with a skyline packer, tallest first, each surrounded by a border of its
+// own edge pixels and kept on a grid as coarse as that border. Only the mipmap levels that border covers are used,
+// so no level blends neighbours
+class TextureAtlas
+{
+public:
+	static constexpr size_t npos = static_cast<size_t>(-1);
+
+	TextureAtlas(int pageSize = 2048, int maxSpriteSize = 256, int padding = 8);
+	TextureAtlas(const TextureAtlas&) = delete;
+	TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+	size_t Add(const std::string& path);
+	void Build();
+	void Unload();
+
+	// Getters
+	const Sprite& GetSprite(size_t index) const;
+	size_t GetPageCount() const { return pages.size(); }
+
+private:
+	// The top of the packed area over a run of columns, the runs are kept left to right
+	struct Segment {
+		int x;
+		int y;
+		int width;
+	};
+
+	bool FindPlace(const std::vector<Segment>& skyline, int width, int height, int& bestX, int& bestY) const;
+	static void Raise(std::vector<Segment>& skyline, int x, int y, int width, int height);
+	void CopyPadded(Image& page, const Image& image, int x, int y) const;
+
+	int pageSize;
+	int maxSpriteSize;  // Larger images are scaled down when they are added, no sprite is drawn bigger than this
+	int padding;
+	int mipmapCount = 1;  // Levels uploaded for each page, as many as the padding keeps sprites apart in
+
+	std::vector<Image> images;  // Waiting to be packed, freed by Build
+	std::vector<std::string> imagePaths;  // Of the images waiting, to report any that cannot be packed
+	std::vector<Sprite> sprites;
+	std::vector<Texture2D> pages;
+};
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "slotMap.h"
+
+// Timers are referred to by the same kind of generational handle as slot map values, so cancelling a timer that has
+// already fired or been cancelled does nothing
+using TimerHandle = SlotHandle;
+
+// Fires payloads at deadlines, hashed into wheels of slots by how far away they are. Each level's slots cover the
+// whole of the level below, and a slot is moved down a level when time reaches it, so scheduling and cancelling are
+// O(1) and advancing costs the ticks passed and timers fired, however many timers are waiting
+template<typename T>
+class TimerWheel
+{
+public:
+	explicit TimerWheel(float tickLength = 1.f / 60.f) : tickLength(tickLength) {}
+
+	// Fires the payload once delay seconds have passed, rounded up to the next tick
+	TimerHandle Schedule(float delay, const T& payload)
+	{
+		std::uint64_t ticks = delay > 0.f ? static_cast<std::uint64_t>(std::ceil(delay / tickLength)) : 0;
+		if (ticks == 0) ticks = 1;
+
+		std::uint32_t index;
+		if (freeTimer != SlotHandle::noIndex) {
+			index = freeTimer;
+			freeTimer = timers[index].nextFree;
+		}
+		else {
+			index = static_cast<std::uint32_t>(timers.size());
+			timers.push_back({});
+		}
+
+		Timer& timer = timers[index];
+		timer.deadline = currentTick + ticks;
+		timer.payload = payload;
+		timer.pending = true;
+		pendingCount++;
+
+		TimerHandle handle{ index, timer.generation };
+		Place(handle);
+		return handle;
+	}
+
+	// Returns false if the timer had already fired or been cancelled. Its entry in the wheel is skipped when reached
+	bool Cancel(TimerHandle handle)
+	{
+		if (!IsPending(handle)) return false;
+		Free(handle.index);
+		return true;
+	}
+
+	bool IsPending(TimerHandle handle) const
+	{
+		return handle.index < timers.size() && timers[handle.index].generation == handle.generation && timers[handle.index].pending;
+	}
+
+	// Moves time on, calling fire with the payload of every timer that comes due in the order they were due.
+	// Timers scheduled by fire are never due until a later tick
+	template<typename Fire>
+	void Advance(float deltaTime, Fire&& fire)
+	{
+		untickedTime += deltaTime;
+		std::uint64_t ticks = static_cast<std::uint64_t>(untickedTime / tickLength);
+		untickedTime -= static_cast<float>(ticks) * tickLength;
+
+		// With nothing waiting there is nothing to move down or fire
+		if (pendingCount == 0) {
+			currentTick += ticks;
+			return;
+		}
+
+		for (; ticks > 0; ticks--) {
+			currentTick++;
+
+			// Moves down the slots of every level the lower levels have just wrapped around into
+			int topLevel = 0;
+			while (topLevel + 1 < levelCount && (currentTick & LevelMask(topLevel + 1)) == 0) topLevel++;
+			for (int level = topLevel; level > 0; level--) Cascade(level);
+
+			firing.swap(wheel[0][currentTick & slotMask]);
+			for (TimerHandle handle : firing) {
+				if (!IsPending(handle)) continue;
+				T payload = timers[handle.index].payload;
+				Free(handle.index);
+				fire(payload);
+			}
+			firing.clear();
+		}
+	}
+
+	// Drops every timer, leaving every handle given out so far stale
+	void Clear()
+	{
+		for (auto& level : wheel) {
+			for (auto& slot : level) slot.clear();
+		}
+		for (std::uint32_t index = 0; index < timers.size(); index++) {
+			if (timers[index].pending) Free(index);
+		}
+	}
+
+	// Getters
+	size_t GetPendingCount() const { return pendingCount; }
+	float GetTickLength() const { return tickLength; }
+
+private:
+	static constexpr int slotBits = 6;
+	static constexpr int levelCount = 4;
+	static constexpr std::uint64_t slotCount = 1ull << slotBits;
+	static constexpr std::uint64_t slotMask = slotCount - 1;
+
+	struct Timer {
+		std::uint64_t deadline = 0;
+		T payload{};
+		std::uint32_t generation = 0;
+		std::uint32_t nextFree = SlotHandle::noIndex;
+		bool pending = false;
+	};
+
+	// The bits of a tick below the given level, which are all zero when that level's slot changes
+	static constexpr std::uint64_t LevelMask(int level) { return (1ull << (slotBits * level)) - 1; }
+
+	// Puts a timer in the lowest level whose slots reach its deadline, or the far end of the top level if none do
+	void Place(TimerHandle handle)
+	{
+		std::uint64_t deadline = timers[handle.index].deadline;
+		std::uint64_t remaining = deadline > currentTick ? deadline - currentTick : 0;
+
+		for (int level = 0; level < levelCount; level++) {
+			if (remaining < (slotCount << (slotBits * level))) {
+				wheel[level][(deadline >> (slotBits * level)) & slotMask].push_back(handle);
+				return;
+			}
+		}
+		int top = levelCount - 1;
+		wheel[top][((currentTick >> (slotBits * top)) - 1) & slotMask].push_back(handle);
+	}
+
+	// Places the timers in a level's current slot again, which puts each one in a lower level
+	void Cascade(int level)
+	{
+		std::vector<TimerHandle>& slot = wheel[level][(currentTick >> (slotBits * level)) & slotMask];
+		cascading.swap(slot);
+		for (TimerHandle handle : cascading) {
+			if (IsPending(handle)) Place(handle);
+		}
+		cascading.clear();
+	}
+
+	void Free(std::uint32_t index)
+	{
+		Timer& timer = timers[index];
+		timer.pending = false;
+		timer.generation++;
+		timer.nextFree = freeTimer;
+		freeTimer = index;
+		pendingCount--;
+	}
+
+	float tickLength;
+	float untickedTime = 0.f;  // Time passed since the last whole tick
+	std::uint64_t currentTick = 0;
+
+	std::vector<Timer> timers;
+	std::uint32_t freeTimer = SlotHandle::noIndex;
+	size_t pendingCount = 0;
+
+	std::array<std::array<std::vector<TimerHandle>, slotCount>, levelCount> wheel;
+	std::vector<TimerHandle> firing;  // Kept between ticks so firing never allocates
+	std::vector<TimerHandle> cascading;
+};
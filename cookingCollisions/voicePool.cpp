@@ -0,0 +1,105 @@
+#include "voicePool.h"
+#include <algorithm>
+#include <iostream>
+
+// Loads a sound and makes its voices, returning noEffect if the file could not be loaded
+VoicePool::EffectId VoicePool::Load(std::string_view name, const std::string& path, float volume, size_t voiceCount, std::uint8_t priority)
+{
+	Sound sound = LoadSound(path.c_str());
+	if (sound.frameCount == 0) {
+		std::cerr << "Could not load " << path << ", " << name << " will not play" << std::endl;
+		return noEffect;
+	}
+	SetSoundVolume(sound, volume);
+
+	Effect effect;
+	effect.name = name;
+	effect.sound = sound;
+	effect.firstVoice = static_cast<std::uint32_t>(voices.size());
+	effect.voiceCount = static_cast<std::uint32_t>(voiceCount);
+	effect.priority = priority;
+
+	// Aliases share the sound's samples and copy its volume
+	for (size_t i = 0; i < voiceCount; i++) {
+		Voice voice;
+		voice.alias = LoadSoundAlias(sound);
+		voice.generation = firstGeneration;
+		voices.push_back(voice);
+	}
+
+	effects.push_back(std::move(effect));
+	return static_cast<EffectId>(effects.size() - 1);
+}
+
+// Unloads every voice and sound. Voices loaded afterwards start past every generation given out so far, so old voice
+// handles stay stale, but effect IDs are reused and have to be found again
+void VoicePool::Unload()
+{
+	for (Voice& voice : voices) {
+		UnloadSoundAlias(voice.alias);
+		firstGeneration = std::max(firstGeneration, voice.generation + 1);
+	}
+	for (Effect& effect : effects) UnloadSound(effect.sound);
+	voices.clear();
+	effects.clear();
+}
+
+// Plays an effect on a free voice, or on the voice it takes over. Returns a null handle if every voice is playing at
+// a higher priority
+VoiceHandle VoicePool::Play(EffectId effect, std::uint8_t priority)
+{
+	if (effect >= effects.size()) return {};
+	const Effect& played = effects[effect];
+
+	std::uint32_t chosen = SlotHandle::noIndex;
+	for (std::uint32_t index = played.firstVoice; index < played.firstVoice + played.voiceCount; index++) {
+		const Voice& voice = voices[index];
+		if (!IsSoundPlaying(voice.alias)) {
+			chosen = index;
+			break;
+		}
+
+		// Keeps the voice playing at the lowest priority, and the oldest of those
+		if (voice.priority > priority) continue;
+		if (chosen == SlotHandle::noIndex || voice.priority < voices[chosen].priority ||
+			(voice.priority == voices[chosen].priority && voice.startedAt < voices[chosen].startedAt)) {
+			chosen = index;
+		}
+	}
+	if (chosen == SlotHandle::noIndex) return {};
+
+	Voice& voice = voices[chosen];
+	voice.generation++;
+	voice.startedAt = ++playCount;
+	voice.priority = priority;
+	PlaySound(voice.alias);  // Restarts the alias if it was taken over
+	return { chosen, voice.generation };
+}
+
+void VoicePool::Stop(VoiceHandle voice)
+{
+	if (IsCurrent(voice)) StopSound(voices[voice.index].alias);
+}
+
+void VoicePool::StopAll(EffectId effect)
+{
+	if (effect >= effects.size()) return;
+	const Effect& stopped = effects[effect];
+	for (std::uint32_t index = stopped.firstVoice; index < stopped.firstVoice + stopped.voiceCount; index++) {
+		StopSound(voices[index].alias);
+	}
+}
+
+// Finds an effect by the name it was loaded with, for resolving effects once after loading rather than on every play
+VoicePool::EffectId VoicePool::Find(std::string_view name) const
+{
+	for (size_t effect = 0; effect < effects.size(); effect++) {
+		if (effects[effect].name == name) return static_cast<EffectId>(effect);
+	}
+	return noEffect;
+}
+
+bool VoicePool::IsPlaying(VoiceHandle voice) const
+{
+	return IsCurrent(voice) && IsSoundPlaying(voices[voice.index].alias);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "slotMap.h"
+
+// Refers to one play of an effect. A voice taken over by a later play leaves the handle stale, so stopping through
+// it never cuts off the newer sound
+using VoiceHandle = SlotHandle;
+
+// Plays sound effects through a fixed number of voices each, aliases of one loaded sound that share its samples.
+// Every voice is made when its effect is loaded, so playing never loads or allocates, and an effect played while all
+// of its voices are busy takes over the one playing at the lowest priority, the oldest of those if there are several
+class VoicePool
+{
+public:
+	using EffectId = std::uint16_t;
+	static constexpr EffectId noEffect = UINT16_MAX;
+
+	VoicePool() = default;
+	VoicePool(const VoicePool&) = delete;
+	VoicePool& operator=(const VoicePool&) = delete;
+
+	EffectId Load(std::string_view name, const std::string& path, float volume, size_t voiceCount, std::uint8_t priority = 0);
+	void Unload();
+
+	VoiceHandle Play(EffectId effect) { return Play(effect, effect < effects.size() ? effects[effect].priority : 0); }
+	VoiceHandle Play(EffectId effect, std::uint8_t priority);
+	void Stop(VoiceHandle voice);
+	void StopAll(EffectId effect);
+
+	// Getters
+	EffectId Find(std::string_view name) const;
+	bool IsPlaying(VoiceHandle voice) const;
+
+private:
+	struct Effect {
+		std::string name;  // Only looked up while loading
+		Sound sound{};
+		std::uint32_t firstVoice = 0;
+		std::uint32_t voiceCount = 0;
+		std::uint8_t priority = 0;  // Used when a play does not give its own
+	};
+
+	struct Voice {
+		Sound alias{};
+		std::uint32_t generation = 0;  // Bumped by every play, which leaves the handles of earlier plays stale
+		std::uint32_t startedAt = 0;  // The play count when the voice started, so the oldest voice can be found
+		std::uint8_t priority = 0;
+	};
+
+	bool IsCurrent(VoiceHandle voice) const { return voice.index < voices.size() && voices[voice.index].generation == voice.generation; }
+
+	std::vector<Effect> effects;
+	std::vector<Voice> voices;  // Each effect's voices are next to each other
+	std::uint32_t playCount = 0;
+	std::uint32_t firstGeneration = 0;  // Where the voices of the next load start, past those of every unloaded voice
+};
@@ -0,0 +1,570 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "../cookingCollisions/frozenRecipeGraph.h"
+#include "../cookingCollisions/recipeGraph.h"
+#include "../cookingCollisions/recipeLoader.h"
+#include "../cookingCollisions/recipePlanner.h"
+#include "../cookingCollisions/shippedRecipes.h"
+
+// Times RecipeGraph queries against the string-keyed implementation they replaced, name lookups, and how the graph scales.
+// Build in Release and run from a console: recipeBenchmark.exe [options]
+//   --fan-in <n>        ingredients per recipe in the scaling graphs, 2 by default
+//   --tools <percent>   share of scaling graph nodes made with a tool instead of a recipe, 10 by default
+//   --max-nodes <n>     largest scaling graph, 100000 by default
+//   --gate              checks the results against the legacy scan and that lookups stay constant time,
+//                       returning 1 if either fails
+
+// The FindCommonNode implementation from before the combination table, kept as the baseline
+std::string LegacyFindCommonNode(const RecipeGraph& recipes, const std::string& node1, const std::string& node2)
+{
+	const auto& neighbors1 = recipes.GetNeighbors(node1);
+	const auto& neighbors2 = recipes.GetNeighbors(node2);
+
+	std::unordered_set<std::string> set1;
+
+	for (const auto& neighbor : neighbors1) {
+		set1.insert(neighbor.destination);
+	}
+
+	std::string commonNode = "NULL";
+	for (const auto& neighbor : neighbors2) {
+		if (set1.count(neighbor.destination)) commonNode = neighbor.destination;
+	}
+
+	return commonNode;
+}
+
+// The shape of a generated recipe graph
+struct GraphShape {
+	int nodeCount;
+	int fanIn = 2;  // Ingredients in each recipe
+	int toolPercent = 10;  // Share of the nodes that are not raw ingredients made by applying a tool
+	unsigned seed = 1;
+};
+
+// Builds a random DAG where the first fifth of the nodes are raw ingredients and every other node
+// is either a recipe of earlier nodes or an earlier node run through a tool. Any share of tools above
+// zero makes at least one tool edge, so even the smallest graph has tool queries to time
+void BuildSyntheticGraph(RecipeGraph& recipes, const GraphShape& shape)
+{
+	std::mt19937 rng(shape.seed);
+	int sourceCount = std::max(1, shape.nodeCount / 5);
+	const std::vector<std::string> tools = { "frying pan", "chopping board", "saucepan" };
+
+	for (int i = 0; i < shape.nodeCount; i++) {
+		recipes.AddNode("item " + std::to_string(i));
+	}
+
+	bool madeToolEdge = false;
+	for (int i = sourceCount; i < shape.nodeCount; i++) {
+		std::string node = "item " + std::to_string(i);
+		std::uniform_int_distribution<int> earlier(0, i - 1);
+
+		bool isLast = i == shape.nodeCount - 1;
+		if (static_cast<int>(rng() % 100) < shape.toolPercent || (isLast && !madeToolEdge && shape.toolPercent > 0)) {
+			recipes.AddEdge("item " + std::to_string(earlier(rng)), node, tools[rng() % tools.size()]);
+			madeToolEdge = true;
+		}
+		else {
+			for (int ingredient = 0; ingredient < shape.fanIn; ingredient++) {
+				recipes.AddEdge("item " + std::to_string(earlier(rng)), node);
+			}
+		}
+	}
+}
+
+// Builds one dish whose recipe tree is the given number of levels deep. A quarter of the steps use a tool,
+// the rest combine two items, and raw ingredients are shared between branches where that keeps every pair unique
+RecipeGraph::ItemId BuildDeepRecipe(RecipeGraph& recipes, int depth, std::mt19937& rng, int& nextNode)
+{
+	const int sourceCount = 8;
+	if (depth == 0) {
+		std::string source = "item " + std::to_string(rng() % sourceCount);
+		return recipes.Intern(source);
+	}
+
+	auto freshSource = [&]() {
+		std::string source = "item " + std::to_string(nextNode++);
+		recipes.AddNode(source);
+		return recipes.Intern(source);
+	};
+
+	std::string node = "item " + std::to_string(nextNode++);
+	recipes.AddNode(node);
+
+	if (rng() % 4 == 0) {
+		std::string tool = rng() % 2 ? "frying pan" : "chopping board";
+		RecipeGraph::ItemId child = BuildDeepRecipe(recipes, depth - 1, rng, nextNode);
+		if (recipes.ApplyInputToNode(recipes.GetName(child), tool) != "NULL") child = freshSource();
+		recipes.AddEdge(recipes.GetName(child), node, tool);
+	}
+	else {
+		RecipeGraph::ItemId child1 = BuildDeepRecipe(recipes, depth - 1, rng, nextNode);
+		RecipeGraph::ItemId child2 = BuildDeepRecipe(recipes, depth - 1, rng, nextNode);
+		if (child1 == child2 || recipes.FindCommonNode(child1, child2) || recipes.FindCommonNode(child2, child1)) child2 = freshSource();
+		recipes.AddEdge(recipes.GetName(child1), node);
+		recipes.AddEdge(recipes.GetName(child2), node);
+	}
+	return recipes.Intern(node);
+}
+
+// Half of the queries are pairs that combine, the rest are random and mostly miss, as during play
+std::vector<std::pair<std::string, std::string>> MakeQueries(const RecipeGraph& recipes, size_t count, unsigned seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<size_t> anyNode(0, recipes.GetIdCount() - 1);
+
+	// Any two producers of a node combine into it, found from the reverse index so large graphs are not scanned pair by pair
+	std::vector<std::pair<RecipeGraph::ItemId, RecipeGraph::ItemId>> combining;
+	for (size_t node = 0; node < recipes.GetIdCount() && combining.size() <= count; node++) {
+		const auto& producers = recipes.GetProducers(static_cast<RecipeGraph::ItemId>(node));
+		for (const auto& producer1 : producers) {
+			for (const auto& producer2 : producers) {
+				if (producer1.source != producer2.source) combining.emplace_back(producer1.source, producer2.source);
+			}
+		}
+	}
+
+	std::vector<std::pair<std::string, std::string>> queries;
+	for (size_t i = 0; i < count; i++) {
+		if (i % 2 == 0 && !combining.empty()) {
+			const auto& pair = combining[rng() % combining.size()];
+			queries.emplace_back(recipes.GetName(pair.first), recipes.GetName(pair.second));
+		}
+		else {
+			queries.emplace_back(recipes.GetName(static_cast<RecipeGraph::ItemId>(anyNode(rng))),
+				recipes.GetName(static_cast<RecipeGraph::ItemId>(anyNode(rng))));
+		}
+	}
+	return queries;
+}
+
+// Runs a query over every pair several times and returns the average cost of one call in nanoseconds
+template <typename Pair, typename Query>
+double TimePerCall(const std::vector<Pair>& queries, int repeats, Query query)
+{
+	if (queries.empty()) return 0.0;
+
+	size_t checksum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++) {
+		for (const auto& pair : queries) {
+			checksum += query(pair);
+		}
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	// Keeps the optimiser from removing the loop
+	if (checksum == 1) std::cout << "";
+
+	double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+	return nanoseconds / (static_cast<double>(queries.size()) * repeats);
+}
+
+void BenchmarkFindCommonNode(const std::string& label, const RecipeGraph& recipes)
+{
+	auto queries = MakeQueries(recipes, 20000, 7);
+
+	std::vector<std::pair<RecipeGraph::ItemId, RecipeGraph::ItemId>> idQueries;
+	for (const auto& pair : queries) {
+		idQueries.emplace_back(*recipes.GetId(pair.first), *recipes.GetId(pair.second));
+	}
+
+	double legacy = TimePerCall(queries, 20, [&](const auto& pair) {
+		return LegacyFindCommonNode(recipes, pair.first, pair.second).size();
+	});
+	double byName = TimePerCall(queries, 20, [&](const auto& pair) {
+		return recipes.FindCommonNode(pair.first, pair.second).size();
+	});
+	double byId = TimePerCall(idQueries, 200, [&](const auto& pair) {
+		return static_cast<size_t>(recipes.FindCommonNode(pair.first, pair.second).value_or(0));
+	});
+
+	std::cout << std::fixed << std::setprecision(1)
+		<< std::left << std::setw(24) << label
+		<< std::right << std::setw(10) << recipes.GetIdCount()
+		<< std::setw(14) << legacy
+		<< std::setw(14) << byName
+		<< std::setw(14) << byId
+		<< std::setw(14) << recipes.GetTableMemoryUsage() / 1024.0
+		<< (recipes.GetIdCount() > PairTable::denseLimit ? "  (hashed)" : "  (dense)")
+		<< std::endl;
+}
+
+// Times turning names into IDs with the graph's map, a snapshot's perfect hash and, for the shipped recipes, the compile-time one
+void BenchmarkNameLookup(const std::string& label, const RecipeGraph& recipes, bool isShipped)
+{
+	std::shared_ptr<const FrozenRecipeGraph> snapshot = recipes.Freeze();
+
+	std::mt19937 rng(11);
+	std::vector<std::string> names;
+	for (int i = 0; i < 20000; i++) {
+		names.push_back(recipes.GetName(static_cast<RecipeGraph::ItemId>(rng() % recipes.GetIdCount())));
+	}
+
+	double map = TimePerCall(names, 20, [&](const std::string& name) {
+		return static_cast<size_t>(*recipes.GetId(name));
+	});
+	double perfectHash = TimePerCall(names, 20, [&](const std::string& name) {
+		return static_cast<size_t>(*snapshot->GetId(name));
+	});
+
+	std::cout << std::fixed << std::setprecision(1)
+		<< std::left << std::setw(24) << label
+		<< std::right << std::setw(10) << recipes.GetIdCount()
+		<< std::setw(14) << map
+		<< std::setw(14) << perfectHash;
+	if (isShipped) {
+		std::cout << std::setw(14) << TimePerCall(names, 20, [](const std::string& name) {
+			return static_cast<size_t>(ShippedRecipes::graph.GetId(name));
+		});
+	}
+	std::cout << std::endl;
+}
+
+void BenchmarkPlanner(const std::string& label, const RecipeGraph& recipes, const std::vector<RecipeGraph::ItemId>& dishes)
+{
+	RecipePlanner planner(recipes);
+	size_t steps = 0;
+	for (RecipeGraph::ItemId dish : dishes) {
+		const auto& plan = planner.FindPlan(dish);
+		if (plan) steps += plan->size();
+	}
+
+	double search = TimePerCall(dishes, 20, [&](RecipeGraph::ItemId dish) {
+		planner.ClearCache();
+		return planner.FindPlan(dish)->size();
+	});
+	double cached = TimePerCall(dishes, 20000, [&](RecipeGraph::ItemId dish) {
+		return planner.FindPlan(dish)->size();
+	});
+
+	std::cout << std::fixed << std::setprecision(1)
+		<< std::left << std::setw(24) << label
+		<< std::right << std::setw(10) << static_cast<double>(steps) / dishes.size()
+		<< std::setw(14) << search / 1000.0
+		<< std::setw(14) << cached
+		<< std::endl;
+}
+
+// Replans for a dish every frame while the items held change now and then, as a bot in the kitchen would.
+// Compares keeping a StateHash up to date with hashing the items on every call and with searching every frame
+void BenchmarkReplanning(const std::string& label, const RecipeGraph& recipes, const std::vector<RecipeGraph::ItemId>& dishes)
+{
+	std::vector<RecipeGraph::ItemId> sources;
+	for (size_t id = 0; id < recipes.GetIdCount(); id++) {
+		RecipeGraph::ItemId item = static_cast<RecipeGraph::ItemId>(id);
+		if (recipes.GetProducers(item).empty() && !recipes.GetNeighbors(item).empty()) sources.push_back(item);
+	}
+
+	// One frame in twenty picks up or uses up a raw ingredient
+	std::mt19937 rng(3);
+	std::vector<std::vector<RecipeGraph::ItemId>> frames;
+	std::vector<std::uint64_t> frameHashes;
+	std::vector<RecipeGraph::ItemId> held;
+	RecipePlanner::StateHash heldHash;
+	for (int frame = 0; frame < 2000; frame++) {
+		if (rng() % 20 == 0) {
+			if (!held.empty() && (held.size() >= 4 || rng() % 2)) {
+				size_t index = rng() % held.size();
+				heldHash.Remove(held[index]);
+				held.erase(held.begin() + index);
+			}
+			else {
+				held.push_back(sources[rng() % sources.size()]);
+				heldHash.Add(held.back());
+			}
+		}
+		frames.push_back(held);
+		frameHashes.push_back(heldHash.Get());
+	}
+
+	std::vector<size_t> frameIndices(frames.size());
+	for (size_t i = 0; i < frameIndices.size(); i++) frameIndices[i] = i;
+
+	RecipePlanner planner(recipes);
+	RecipeGraph::ItemId dish = dishes[0];
+	double incremental = TimePerCall(frameIndices, 5, [&](size_t frame) {
+		return planner.FindPlan(dish, frames[frame], frameHashes[frame]).has_value() ? size_t(1) : size_t(0);
+	});
+	double hitRate = 100.0 * planner.GetCacheHits() / std::max<size_t>(1, planner.GetCacheHits() + planner.GetCacheMisses());
+	double rehashed = TimePerCall(frameIndices, 5, [&](size_t frame) {
+		return planner.FindPlan(dish, frames[frame]).has_value() ? size_t(1) : size_t(0);
+	});
+	double search = TimePerCall(frameIndices, 1, [&](size_t frame) {
+		planner.ClearCache();
+		return planner.FindPlan(dish, frames[frame], frameHashes[frame]).has_value() ? size_t(1) : size_t(0);
+	});
+
+	std::cout << std::fixed << std::setprecision(1)
+		<< std::left << std::setw(24) << label
+		<< std::right << std::setw(10) << hitRate
+		<< std::setw(14) << incremental
+		<< std::setw(14) << rehashed
+		<< std::setw(14) << search
+		<< std::endl;
+}
+
+// Results for one graph size in the scaling benchmark, times are nanoseconds per call
+struct ScalingResult {
+	int nodeCount;
+	size_t edgeCount;
+	double buildMilliseconds;
+	double addEdge;
+	double commonByName;
+	double commonById;
+	double applyByName;
+	double applyById;
+	bool hasToolQueries;  // A graph without tool edges has no tool queries, and its apply times are not measured
+	double neighborsByName;
+	double neighborsById;
+	size_t memoryBytes;
+	size_t mismatches;  // Queries where the table disagrees with the legacy scan
+};
+
+// Builds a graph of the given shape and times every query on it. Returns nothing if the graph has more names than the ID type can hold
+std::optional<ScalingResult> MeasureScaling(const GraphShape& shape, bool checkResults)
+{
+	RecipeGraph recipes;
+	auto buildStart = std::chrono::steady_clock::now();
+	try {
+		BuildSyntheticGraph(recipes, shape);
+	}
+	catch (const std::length_error&) {
+		return std::nullopt;
+	}
+	auto buildEnd = std::chrono::steady_clock::now();
+
+	ScalingResult result{};
+	result.nodeCount = shape.nodeCount;
+	for (size_t node = 0; node < recipes.GetIdCount(); node++) {
+		result.edgeCount += recipes.GetNeighbors(static_cast<RecipeGraph::ItemId>(node)).size();
+	}
+	result.buildMilliseconds = std::chrono::duration<double, std::milli>(buildEnd - buildStart).count();
+	result.addEdge = result.buildMilliseconds * 1e6 / std::max<size_t>(1, result.edgeCount);
+	result.memoryBytes = recipes.GetMemoryUsage();
+
+	const int repeats = 5;
+	auto queries = MakeQueries(recipes, 20000, 7);
+	std::vector<std::pair<RecipeGraph::ItemId, RecipeGraph::ItemId>> idQueries;
+	for (const auto& pair : queries) {
+		idQueries.emplace_back(*recipes.GetId(pair.first), *recipes.GetId(pair.second));
+	}
+
+	// Half of the tool queries follow a real tool edge, the rest pair a random item with a random tool
+	std::mt19937 rng(shape.seed);
+	std::vector<std::string> toolNames;
+	for (const char* tool : { "frying pan", "chopping board", "saucepan" }) {
+		if (recipes.GetId(tool)) toolNames.push_back(tool);
+	}
+	std::vector<std::pair<std::string, std::string>> toolQueries;
+	std::vector<std::pair<RecipeGraph::ItemId, RecipeGraph::ItemId>> toolIdQueries;
+	if (!toolNames.empty()) {
+		std::vector<std::pair<RecipeGraph::ItemId, RecipeGraph::ItemId>> toolEdges;
+		for (size_t node = 0; node < recipes.GetIdCount(); node++) {
+			for (const auto& edge : recipes.GetNeighbors(static_cast<RecipeGraph::ItemId>(node))) {
+				if (recipes.GetName(edge.input) != "none") toolEdges.emplace_back(static_cast<RecipeGraph::ItemId>(node), edge.input);
+			}
+		}
+		for (size_t i = 0; i < queries.size(); i++) {
+			if (i % 2 == 0 && !toolEdges.empty()) toolIdQueries.push_back(toolEdges[rng() % toolEdges.size()]);
+			else toolIdQueries.emplace_back(idQueries[i].first, *recipes.GetId(toolNames[rng() % toolNames.size()]));
+			toolQueries.emplace_back(recipes.GetName(toolIdQueries.back().first), recipes.GetName(toolIdQueries.back().second));
+		}
+	}
+
+	result.commonByName = TimePerCall(queries, repeats, [&](const auto& pair) {
+		return recipes.FindCommonNode(pair.first, pair.second).size();
+	});
+	result.commonById = TimePerCall(idQueries, repeats * 10, [&](const auto& pair) {
+		return static_cast<size_t>(recipes.FindCommonNode(pair.first, pair.second).value_or(0));
+	});
+	result.hasToolQueries = !toolQueries.empty();
+	result.applyByName = TimePerCall(toolQueries, repeats, [&](const auto& pair) {
+		return recipes.ApplyInputToNode(pair.first, pair.second).size();
+	});
+	result.applyById = TimePerCall(toolIdQueries, repeats * 10, [&](const auto& pair) {
+		return static_cast<size_t>(recipes.ApplyInputToNode(pair.first, pair.second).value_or(0));
+	});
+	result.neighborsByName = TimePerCall(queries, repeats, [&](const auto& pair) {
+		return recipes.GetNeighbors(pair.first).size();
+	});
+	result.neighborsById = TimePerCall(idQueries, repeats * 10, [&](const auto& pair) {
+		return recipes.GetNeighbors(pair.first).size();
+	});
+
+	// The legacy scan is slow, so only a slice of the queries is checked
+	if (checkResults) {
+		for (size_t i = 0; i < queries.size(); i += 10) {
+			std::optional<RecipeGraph::ItemId> commonNode = recipes.FindCommonNode(idQueries[i].first, idQueries[i].second);
+			std::string expected = LegacyFindCommonNode(recipes, queries[i].first, queries[i].second);
+			if ((commonNode ? recipes.GetName(*commonNode) : "NULL") != expected) result.mismatches++;
+		}
+	}
+
+	return result;
+}
+
+// Times building and querying graphs from ten nodes up to the largest size asked for.
+// Returns false if the gate is on and a result is wrong or id lookups slow down as the graph grows
+bool BenchmarkScaling(int fanIn, int toolPercent, int maxNodes, bool gate)
+{
+	// How much slower an id lookup on the largest graph may be than on a 1000 node one before the gate fails
+	const double gateSlowdown = 8.0;
+
+	std::cout << std::endl << "RecipeGraph scaling, fan-in " << fanIn << ", " << toolPercent << "% tool edges, nanoseconds per call" << std::endl;
+	std::cout << std::left << std::setw(10) << "nodes"
+		<< std::right << std::setw(10) << "edges"
+		<< std::setw(10) << "build ms"
+		<< std::setw(10) << "AddEdge"
+		<< std::setw(12) << "common nm"
+		<< std::setw(12) << "common id"
+		<< std::setw(12) << "apply nm"
+		<< std::setw(12) << "apply id"
+		<< std::setw(12) << "neigh nm"
+		<< std::setw(12) << "neigh id"
+		<< std::setw(10) << "MiB" << std::endl;
+
+	bool passed = true;
+	std::optional<ScalingResult> baseline;
+	std::optional<ScalingResult> largest;
+	for (int nodeCount : { 10, 100, 1000, 10000, 50000, 100000 }) {
+		if (nodeCount > maxNodes) break;
+
+		std::optional<ScalingResult> result = MeasureScaling({ nodeCount, fanIn, toolPercent, 1 }, gate);
+		if (!result) {
+			std::cout << std::left << std::setw(10) << nodeCount << "  does not fit, item IDs are 16 bits and allow "
+				<< RecipeGraph::noItem << " names" << std::endl;
+			continue;
+		}
+
+		// Prints a time, or n/a for the apply columns of a graph with no tool edges
+		auto applyTime = [&](double time) {
+			std::ostringstream text;
+			if (result->hasToolQueries) text << std::fixed << std::setprecision(1) << time;
+			else text << "n/a";
+			return text.str();
+		};
+
+		std::cout << std::fixed << std::setprecision(1)
+			<< std::left << std::setw(10) << result->nodeCount
+			<< std::right << std::setw(10) << result->edgeCount
+			<< std::setw(10) << result->buildMilliseconds
+			<< std::setw(10) << result->addEdge
+			<< std::setw(12) << result->commonByName
+			<< std::setw(12) << result->commonById
+			<< std::setw(12) << applyTime(result->applyByName)
+			<< std::setw(12) << applyTime(result->applyById)
+			<< std::setw(12) << result->neighborsByName
+			<< std::setw(12) << result->neighborsById
+			<< std::setw(10) << result->memoryBytes / (1024.0 * 1024.0) << std::endl;
+
+		if (result->mismatches > 0) {
+			std::cerr << "Gate: " << result->mismatches << " FindCommonNode results differ from the legacy scan at "
+				<< nodeCount << " nodes" << std::endl;
+			passed = false;
+		}
+		if (nodeCount == 1000) baseline = result;
+		largest = result;
+	}
+
+	if (gate && baseline && largest && largest->nodeCount > baseline->nodeCount) {
+		double commonSlowdown = largest->commonById / baseline->commonById;
+		double applySlowdown = largest->hasToolQueries && baseline->hasToolQueries ? largest->applyById / baseline->applyById : 0.0;
+		if (commonSlowdown > gateSlowdown || applySlowdown > gateSlowdown) {
+			std::cerr << "Gate: id lookups at " << largest->nodeCount << " nodes are " << std::setprecision(1)
+				<< std::max(commonSlowdown, applySlowdown) << "x slower than at 1000 nodes" << std::endl;
+			passed = false;
+		}
+	}
+
+	return passed;
+}
+
+int main(int argc, char* argv[])
+{
+	int fanIn = 2;
+	int toolPercent = 10;
+	int maxNodes = 100000;
+	bool gate = false;
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--gate") == 0) gate = true;
+		else if (std::strcmp(argv[i], "--fan-in") == 0 && i + 1 < argc) fanIn = std::max(1, std::atoi(argv[++i]));
+		else if (std::strcmp(argv[i], "--tools") == 0 && i + 1 < argc) toolPercent = std::clamp(std::atoi(argv[++i]), 0, 100);
+		else if (std::strcmp(argv[i], "--max-nodes") == 0 && i + 1 < argc) maxNodes = std::atoi(argv[++i]);
+		else {
+			std::cerr << "Usage: recipeBenchmark [--fan-in <n>] [--tools <percent>] [--max-nodes <n>] [--gate]" << std::endl;
+			return 2;
+		}
+	}
+
+	std::cout << "FindCommonNode, nanoseconds per call" << std::endl;
+	std::cout << std::left << std::setw(24) << "graph"
+		<< std::right << std::setw(10) << "ids"
+		<< std::setw(14) << "legacy"
+		<< std::setw(14) << "by name"
+		<< std::setw(14) << "by id"
+		<< std::setw(14) << "table KiB" << std::endl;
+
+	RecipeGraph shipped;
+	RecipeLoader::LoadShipped(shipped);
+	BenchmarkFindCommonNode("shipped", shipped);
+
+	RecipeGraph synthetic;
+	BuildSyntheticGraph(synthetic, { 5000 });
+	BenchmarkFindCommonNode("synthetic 5000", synthetic);
+
+	std::cout << std::endl << "GetId, nanoseconds per call" << std::endl;
+	std::cout << std::left << std::setw(24) << "graph"
+		<< std::right << std::setw(10) << "ids"
+		<< std::setw(14) << "map"
+		<< std::setw(14) << "perfect hash"
+		<< std::setw(14) << "static" << std::endl;
+	BenchmarkNameLookup("shipped", shipped, true);
+	BenchmarkNameLookup("synthetic 5000", synthetic, false);
+
+	std::cout << std::endl << "RecipePlanner, time per plan" << std::endl;
+	std::cout << std::left << std::setw(24) << "recipes"
+		<< std::right << std::setw(10) << "steps"
+		<< std::setw(14) << "search us"
+		<< std::setw(14) << "cached ns" << std::endl;
+
+	std::vector<RecipeGraph::ItemId> shippedDishes;
+	for (size_t id = 0; id < shipped.GetIdCount(); id++) {
+		RecipeGraph::ItemId dish = static_cast<RecipeGraph::ItemId>(id);
+		if (!shipped.GetProducers(dish).empty() && shipped.GetNeighbors(dish).empty()) shippedDishes.push_back(dish);
+	}
+	BenchmarkPlanner("shipped", shipped, shippedDishes);
+
+	for (int depth : { 4, 5, 6 }) {
+		RecipeGraph deep;
+		std::mt19937 rng(depth);
+		int nextNode = 8;
+		RecipeGraph::ItemId dish = BuildDeepRecipe(deep, depth, rng, nextNode);
+		BenchmarkPlanner("depth " + std::to_string(depth), deep, { dish });
+	}
+
+	std::cout << std::endl << "Replanning every frame, nanoseconds per frame" << std::endl;
+	std::cout << std::left << std::setw(24) << "recipes"
+		<< std::right << std::setw(10) << "hit %"
+		<< std::setw(14) << "state hash"
+		<< std::setw(14) << "rehashed"
+		<< std::setw(14) << "search" << std::endl;
+	BenchmarkReplanning("shipped", shipped, shippedDishes);
+
+	bool passed = BenchmarkScaling(fanIn, toolPercent, maxNodes, gate);
+	return passed ? 0 : 1;
+}